@@ -33,9 +33,8 @@ static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T
 	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
 	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
 	n = std::fabs(h_2 - h_1);
-	// Cross-implementation consistent rounding.
-	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
-		n = T(M_PI);
+	// Cross-implementation consistent rounding, without a branch so that T can be a vector type.
+	n += (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14)) * (T(M_PI) - n);
 	// When the hue angles lie in different quadrants, the straightforward
 	// average can produce a mean that incorrectly suggests a hue angle in
 	// the wrong quadrant, the next lines handle this issue.
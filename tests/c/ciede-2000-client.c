@@ -0,0 +1,399 @@
+// This function written in C is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+// The sockets, threads and monotonic clock of POSIX, which strict C99 hides on Linux.
+#if defined(__linux__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <math.h>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338328
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+static double ciede_2000(const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2) {
+	// Working in C with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const double k_l = 1.0;
+	const double k_c = 1.0;
+	const double k_h = 1.0;
+	double n = (sqrt(a_1 * a_1 + b_1 * b_1) + sqrt(a_2 * a_2 + b_2 * b_2)) * 0.5;
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = 1.0 + 0.5 * (1.0 - sqrt(n / (n + 6103515625.0)));
+	// Application of the chroma correction factor.
+	const double c_1 = sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const double c_2 = sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	double h_1 = atan2(b_1, a_1 * n);
+	double h_2 = atan2(b_2, a_2 * n);
+	h_1 += (h_1 < 0.0) * 2.0 * M_PI;
+	h_2 += (h_2 < 0.0) * 2.0 * M_PI;
+	n = fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (M_PI - 1E-14 < n && n < M_PI + 1E-14)
+		n = M_PI;
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	double h_m = (h_1 + h_2) * 0.5;
+	double h_d = (h_2 - h_1) * 0.5;
+	h_d += (M_PI < n) * M_PI;
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (M_PI < n) * M_PI;
+	// h_m += (M_PI < n) * ((h_m < M_PI) - (M_PI <= h_m)) * M_PI;
+	const double p = 36.0 * h_m - 55.0 * M_PI;
+	n = (c_1 + c_2) * 0.5;
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const double r_t = -2.0 * sqrt(n / (n + 6103515625.0))
+			* sin(M_PI / 3.0 * exp(p * p / (-25.0 * M_PI * M_PI)));
+	n = (l_1 + l_2) * 0.5;
+	n = (n - 50.0) * (n - 50.0);
+	// Lightness.
+	const double l = (l_2 - l_1) / (k_l * (1.0 + 0.015 * n / sqrt(20.0 + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const double t = 1.0	+ 0.24 * sin(2.0 * h_m + M_PI / 2.0)
+				+ 0.32 * sin(3.0 * h_m + 8.0 * M_PI / 15.0)
+				- 0.17 * sin(h_m + M_PI / 3.0)
+				- 0.20 * sin(4.0 * h_m + 3.0 * M_PI / 20.0);
+	n = c_1 + c_2;
+	// Hue.
+	const double h = 2.0 * sqrt(c_1 * c_2) * sin(h_d) / (k_h * (1.0 + 0.0075 * n * t));
+	// Chroma.
+	const double c = (c_2 - c_1) / (k_c * (1.0 + 0.0225 * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 58.1   a1 = 24.9   b1 = -3.1
+// L2 = 57.4   a2 = 20.6   b2 = 2.9
+// CIE ΔE00 = 4.5707971616 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 4.5707827760 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.4e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////          Server Client          ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// This C program is a client of the server mode of the driver (./driver --listen <path>), whose binary protocol
+// is described in "ciede-2000-driver.c". Each thread opens a connection, checks once the one-to-many, the
+// control and the components requests, then sends batches of random pairs to solve, a window of them at a
+// time without waiting for the responses, and compares every ΔE2000 received with ciede_2000 above. At the end, it prints the number of
+// batches per second, and the latency quantiles measured by the server (statistics request).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+#define MAX_THREADS 256
+
+// The header of the requests and of the responses.
+typedef struct {
+	uint32_t size;
+	uint16_t op;
+	uint16_t flags;
+	uint32_t id;
+	uint32_t count;
+} header;
+
+enum { SOLVE = 1, ONE_TO_MANY, CONTROL, STATISTICS, SHUTDOWN, COMPONENTS };
+
+typedef struct {
+	struct {
+		const char *path;
+		double seconds;
+		double tolerance;
+		int threads;
+		int pairs;
+		int window;
+		int shutdown;
+		int help;
+	} params;
+	int code;
+} state;
+
+typedef struct {
+	const state *state;
+	pthread_t thread;
+	uint64_t seed;
+	uint64_t n_batches;
+	uint64_t n_mismatches;
+	int failed;
+} worker;
+
+static uint64_t get_time_ms(void) {
+	// returns the current Unix timestamp with milliseconds.
+	struct timeval time;
+	gettimeofday(&time, 0);
+	return (uint64_t) time.tv_sec * 1000 + (uint64_t) time.tv_usec / 1000;
+}
+
+static inline uint64_t xor_random(uint64_t *s) {
+	return *s ^= *s << 13, *s ^= *s >> 7, *s ^= *s << 17;
+}
+
+static inline double uniform(uint64_t *s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int connect_to(const char *path) {
+	struct sockaddr_un address = {0};
+	const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+	if (fd != -1 && connect(fd, (struct sockaddr *) &address, sizeof(address))) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+static int write_all(const int fd, const void *data, size_t n) {
+	for (const char *p = data; n;) {
+		const ssize_t m = write(fd, p, n);
+		if (m < 0 && errno != EINTR)
+			return 0;
+		if (0 < m)
+			p += m, n -= (size_t) m;
+	}
+	return 1;
+}
+
+static int read_all(const int fd, void *data, size_t n) {
+	for (char *p = data; n;) {
+		const ssize_t m = read(fd, p, n);
+		if (m == 0 || (m < 0 && errno != EINTR))
+			return 0;
+		if (0 < m)
+			p += m, n -= (size_t) m;
+	}
+	return 1;
+}
+
+static int request(const int fd, const uint16_t op, const uint32_t id, const uint32_t count, const void *body, const uint32_t size) {
+	const header h = {size, op, 0, id, count};
+	return write_all(fd, &h, sizeof(h)) && write_all(fd, body, size);
+}
+
+static int response(const int fd, header *h, void *body, const uint32_t max_size) {
+	// Reads a response, whose body must fit in max_size bytes.
+	return read_all(fd, h, sizeof(*h)) && h->size <= max_size && read_all(fd, body, h->size);
+}
+
+static int check_operations(const int fd, worker *w) {
+	// A one-to-many request, a control request whose last ΔE2000 is wrong, then a components request.
+	double x[1 + 7 * 8], y[8], z[8 * 8];
+	header h;
+	int ok;
+	for (int i = 0; i < 3; ++i)
+		x[i] = uniform(&w->seed, 0.0, 100.0) - 50.0 * (i != 0);
+	for (int i = 0; i < 8; ++i)
+		for (int j = 0; j < 3; ++j)
+			x[3 + 3 * i + j] = uniform(&w->seed, 0.0, 100.0) - 50.0 * (j != 0);
+	ok = request(fd, ONE_TO_MANY, 1, 8, x, 27 * sizeof(double)) && response(fd, &h, y, sizeof(y));
+	ok = ok && h.flags == 0 && h.id == 1 && h.count == 8 && h.size == sizeof(y);
+	for (int i = 0; ok && i < 8; ++i)
+		ok = fabs(y[i] - ciede_2000(x[0], x[1], x[2], x[3 + 3 * i], x[4 + 3 * i], x[5 + 3 * i])) <= w->state->params.tolerance;
+	x[0] = w->state->params.tolerance;
+	for (int i = 0; i < 8; ++i) {
+		double *p = x + 1 + 7 * i;
+		p[0] = uniform(&w->seed, 0.0, 100.0), p[1] = uniform(&w->seed, -128.0, 128.0), p[2] = uniform(&w->seed, -128.0, 128.0);
+		p[3] = uniform(&w->seed, 0.0, 100.0), p[4] = uniform(&w->seed, -128.0, 128.0), p[5] = uniform(&w->seed, -128.0, 128.0);
+		p[6] = ciede_2000(p[0], p[1], p[2], p[3], p[4], p[5]) + (i == 7);
+	}
+	uint64_t result[3];
+	ok = ok && request(fd, CONTROL, 2, 8, x, 57 * sizeof(double)) && response(fd, &h, result, sizeof(result));
+	ok = ok && h.flags == 0 && h.size == sizeof(result) && result[0] == 1 && result[1] == 7;
+	// The rows are ΔL', ΔC', ΔH', S_L, S_C, S_H, R_T and the ΔE2000.
+	for (int i = 0; i < 8; ++i)
+		memcpy(z + 6 * i, x + 1 + 7 * i, 6 * sizeof(double));
+	ok = ok && request(fd, COMPONENTS, 3, 8, z, 48 * sizeof(double)) && response(fd, &h, z, sizeof(z));
+	ok = ok && h.flags == 0 && h.id == 3 && h.count == 8 && h.size == sizeof(z);
+	for (int i = 0; ok && i < 8; ++i) {
+		const double *p = x + 1 + 7 * i, *t = z + 8 * i;
+		ok = t[0] == p[3] - p[0] && fabs(t[7] - ciede_2000(p[0], p[1], p[2], p[3], p[4], p[5])) <= w->state->params.tolerance;
+	}
+	return ok;
+}
+
+static void *run_worker(void *arg) {
+	worker *w = arg;
+	const state *state = w->state;
+	const int n = state->params.pairs, window = state->params.window;
+	double *pairs = malloc((size_t) window * n * 6 * sizeof(double)), *delta_e = malloc((size_t) n * sizeof(double));
+	const int fd = connect_to(state->params.path);
+	w->failed = fd == -1 || pairs == 0 || delta_e == 0 || !check_operations(fd, w);
+	const uint64_t end = get_time_ms() + (uint64_t) (state->params.seconds * 1000.0);
+	for (uint32_t id = 0; !w->failed && get_time_ms() < end;) {
+		// A window of requests is sent, then the responses are read and verified.
+		for (int i = 0; i < window; ++i) {
+			double *p = pairs + (size_t) i * n * 6;
+			for (int j = 0; j < n; ++j, p += 6) {
+				p[0] = uniform(&w->seed, 0.0, 100.0), p[1] = uniform(&w->seed, -128.0, 128.0), p[2] = uniform(&w->seed, -128.0, 128.0);
+				p[3] = uniform(&w->seed, 0.0, 100.0), p[4] = uniform(&w->seed, -128.0, 128.0), p[5] = uniform(&w->seed, -128.0, 128.0);
+			}
+		}
+		for (int i = 0; !w->failed && i < window; ++i)
+			w->failed = !request(fd, SOLVE, id + (uint32_t) i, (uint32_t) n, pairs + (size_t) i * n * 6, (uint32_t) (n * 6 * sizeof(double)));
+		for (int i = 0; !w->failed && i < window; ++i) {
+			header h;
+			const double *p = pairs + (size_t) i * n * 6;
+			w->failed = !response(fd, &h, delta_e, (uint32_t) (n * sizeof(double))) || h.flags || h.id != id + (uint32_t) i || h.count != (uint32_t) n;
+			for (int j = 0; !w->failed && j < n; ++j, p += 6)
+				w->n_mismatches += !(fabs(delta_e[j] - ciede_2000(p[0], p[1], p[2], p[3], p[4], p[5])) <= state->params.tolerance);
+		}
+		id += (uint32_t) window;
+		w->n_batches += (uint64_t) window;
+	}
+	if (fd != -1)
+		close(fd);
+	free(pairs), free(delta_e);
+	return 0;
+}
+
+static void run(state *state) {
+	worker *workers = calloc((size_t) state->params.threads, sizeof(*workers));
+	uint64_t n_batches = 0, n_mismatches = 0;
+	int n_started = 0, n_failed = 0;
+	const uint64_t time_1 = get_time_ms();
+	for (; workers && n_started < state->params.threads; ++n_started) {
+		workers[n_started].state = state;
+		workers[n_started].seed = 0x9e3779b97f4a7c15ULL * (uint64_t) (n_started + 1) ^ time_1;
+		if (pthread_create(&workers[n_started].thread, 0, run_worker, workers + n_started))
+			break;
+	}
+	for (int i = 0; i < n_started; ++i) {
+		pthread_join(workers[i].thread, 0);
+		n_batches += workers[i].n_batches, n_mismatches += workers[i].n_mismatches, n_failed += workers[i].failed;
+	}
+	const double seconds = (double) (get_time_ms() - time_1) / 1000.0;
+	free(workers);
+	if (n_started == 0) {
+		perror("Delta E 2000");
+		state->code = 4;
+		return;
+	}
+	printf("Solved %" PRIu64 " batches of %d pairs over %d connections in %.2f s : %.0f batches per second, %.0f pairs per second.\n", n_batches, state->params.pairs, n_started, seconds, (double) n_batches / seconds, (double) n_batches * state->params.pairs / seconds);
+	// The server reports the latencies of all its clients, and stops on request.
+	const int fd = connect_to(state->params.path);
+	header h;
+	char text[4096];
+	if (fd != -1 && request(fd, STATISTICS, 0, 0, 0, 0) && response(fd, &h, text, sizeof(text) - 1)) {
+		text[h.size] = 0;
+		printf("%s", text);
+	}
+	if (fd != -1 && state->params.shutdown && request(fd, SHUTDOWN, 0, 0, 0, 0))
+		response(fd, &h, text, 0);
+	if (fd != -1)
+		close(fd);
+	if (n_failed || n_mismatches) {
+		printf("  - FAIL : %d connections failed, %" PRIu64 " ΔE2000 differ from ciede_2000\n", n_failed, n_mismatches);
+		state->code = 1;
+	} else
+		printf("  - PASS : Every ΔE2000 received matches ciede_2000\n");
+}
+
+#define DeltaE(a, b, c) if (!strcmp(key, "--" #a) || !strcmp(key, "-" #b)) (c)
+static int read_arg_2(const char **argv, state *state) {
+	// Reads a key/value parameter received on the command line.
+	const char *key = *argv, *value = *(argv + 1);
+	DeltaE(duration, d, state->params.seconds = strtod(value, 0));
+	else DeltaE(listen, l, state->params.path = value);
+	else DeltaE(pairs, n, state->params.pairs = (int) strtol(value, 0, 10));
+	else DeltaE(threads, j, state->params.threads = (int) strtol(value, 0, 10));
+	else DeltaE(tolerance, t, state->params.tolerance = strtod(value, 0));
+	else DeltaE(window, w, state->params.window = (int) strtol(value, 0, 10));
+	else
+		return 0;
+	return 1;
+}
+
+static int read_arg_1(const char **argv, state *state) {
+	// Reads a flag received on the command line.
+	const char *key = *argv;
+	DeltaE(help, h, state->params.help = 1);
+	else DeltaE(shutdown, x, state->params.shutdown = 1);
+	else
+		return 0;
+	return 1;
+}
+#undef DeltaE
+
+static void print_help(void) {
+	puts("           Name: Delta E 2000 Server Client");
+	puts("    Description: Check and measure the server mode of the driver (--listen)");
+	puts("");
+	puts("     Options:");
+	puts("       -l <path> or --listen to specify the socket of the server (required)");
+	puts("       -j <count> or --threads to customize the number of connections (default to 4)");
+	puts("       -n <count> or --pairs to customize the number of pairs per batch (default to 16)");
+	puts("       -w <count> or --window to customize the batches sent before reading (default to 32)");
+	puts("       -d <seconds> or --duration to customize the duration (default to 3)");
+	puts("       -t <value> or --tolerance to customize the accepted deviation (default to 1e-10)");
+	puts("       -x or --shutdown to stop the server at the end");
+	puts("");
+	puts(" GitHub Project: https://github.com/michel-leonard/ciede2000-color-matching");
+}
+
+int main(int argc, const char *argv[]) {
+	state state = {0};
+	state.params.seconds = 3.0;
+	state.params.tolerance = 1E-10;
+	state.params.threads = 4;
+	state.params.pairs = 16;
+	state.params.window = 32;
+	for (int i = 1; i < argc; ++i)
+		if (!(i + 1 < argc && read_arg_2(argv + i, &state) && ++i))
+			if (!read_arg_1(argv + i, &state))
+				fprintf(stderr, "Delta E 2000: Unknown argument '%s'.\n", (state.code = 2, argv[i]));
+	if (state.params.threads < 1 || MAX_THREADS < state.params.threads)
+		state.params.threads = state.params.threads < 1 ? 1 : MAX_THREADS;
+	if (state.params.pairs < 1 || 1 << 20 < state.params.pairs)
+		state.params.pairs = 16;
+	if (state.params.window < 1 || 4096 < state.params.window)
+		state.params.window = 32;
+	if (state.params.help)
+		print_help();
+	else if (state.code == 0 && state.params.path == 0) {
+		fprintf(stderr, "Delta E 2000: The socket of the server must be specified with -l.\n");
+		state.code = 2;
+	} else if (state.code == 0)
+		run(&state);
+	return state.code;
+}
+
+// This file is named "ciede-2000-client.c"
+
+// The compilation is done using GCC or CLang :
+// - gcc -std=c99 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-client ciede-2000-client.c -lm
+// - clang -std=c99 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-client ciede-2000-client.c -lm
@@ -6,6 +6,13 @@
 
 // © Michel Leonard 2025
 
+// The server mode (option --listen) uses the POSIX sockets and threads, which strict C99 hides on Linux, and the
+// checkpoints use ftello and fseeko, whose off_t has 64 bits on 32-bit systems too with _FILE_OFFSET_BITS.
+#if defined(__linux__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#define _FILE_OFFSET_BITS 64
+
 #include <math.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -14,6 +21,76 @@
 #include <inttypes.h>
 #include <sys/time.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define DELTAE_SERVER
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+// What a checkpoint saves, so that generate, solve and control can resume where they stopped.
+typedef struct {
+	uint64_t input_offset;
+	uint64_t output_offset;
+	uint64_t seed;
+	uint64_t index;
+	uint64_t n_lines;
+	uint64_t n_errors;
+	uint64_t n_successes;
+	uint64_t errors_displayed;
+	uint64_t n_default; // With --both, the lines that tell the conventions apart and are closer to the default one.
+	uint64_t n_canonical; // And those closer to the canonical one.
+	uint64_t elapsed_ms;
+	double max_error;
+	double sum_errors;
+	double sum_delta_e;
+	int do_copy;
+	int resumed;
+} progress;
+
+// A constant-memory distribution of non-negative values, in logarithmic buckets from 2^-64 to 2^64 (64 buckets
+// per power of 2, so that the quantiles are within 0.8% of the exact ones), the first bucket also holding the
+// smaller values and zeros. Two sketches, of two threads or of two parts of a file, merge by adding their counts.
+#define SKETCH_SUB_BITS 6
+#define SKETCH_BUCKETS (128 << SKETCH_SUB_BITS)
+typedef struct {
+	uint64_t count[SKETCH_BUCKETS];
+	uint64_t n;
+	double min;
+	double max;
+} sketch;
+
+// FUZZER BEGIN : these tiers and the kernels of the next marked region are extracted by ".github/workflows/fuzzer.yml".
+
+// An accuracy tier (option --accuracy) replaces atan2, sin and exp with polynomials, as near-minimax fits of
+// atan(x) / x and sin(x) / x in x², and of exp(-u). The contract bounds the deviation from the exact ΔE2000.
+// The fast tier of "tests/cpp/ciede-2000-accuracy.cpp" isn't offered here : its speed comes from vectorized
+// 32-bit batches, while the driver solves line by line, its time being mostly spent parsing and printing.
+typedef struct {
+	const char *name;
+	double contract;
+	int n_atan;
+	int n_sin;
+	int n_exp;
+	double atan[8];
+	double sin[6];
+	double exp[8];
+} tier;
+
+static const tier tiers[ ] = {
+	{"balanced", 1E-4, 8, 6, 8,
+		{0.999999336, -0.333298625, 0.199465829, -0.139087088, 0.0964238537, -0.0559147289, 0.0218645266, -0.00405497824},
+		{1.0, -0.166666666, 0.00833332987, -0.000198407591, 2.75211363e-06, -2.38282978e-08},
+		{0.999999994, -0.99999951, 0.499992929, -0.166626094, 0.0415485729, -0.0081409151, 0.00120849774, -0.000104033535}}
+};
+
+// FUZZER END
+
 typedef struct {
 	struct {
 		uint64_t seed;
@@ -22,12 +99,28 @@ typedef struct {
 		const char *delimiter;
 		const char *input_file;
 		const char *output_file;
+		const char *checkpoint;
+		const char *histogram;
+		const char *accuracy;
+		const char *listen;
+		int threads;
 		int canonical; // The deviation between 0 and 1 (option --canonical) can be up to ±0.0003 in ΔE2000 results.
+		int both; // Solve appends the ΔE2000 of both conventions, and control accepts either.
+		int components; // Solve appends the terms of the ΔE2000 (see ciede_2000_components), then the ΔE2000.
+		int group;
 		int precision;
 		int verbose;
+		int self_test;
+		int no_self_test;
 		int help;
 		char mode;
 	} params;
+	progress progress;
+	sketch delta_e; // The distribution of the ΔE2000, in solve and control.
+	sketch deviation; // The distribution of the deviations, in control.
+	const tier *tier; // The accuracy tier of solve, and whose contract control tolerates, null when exact.
+	uint64_t time_1;
+	uint64_t checkpoint_time;
 	char buf_1[255];
 	char buf_2[255];
 	char format[127];
@@ -329,12 +422,17 @@ static const reference references[ ] = {
 static int read_arg_2(const char **argv, state *state) {
 	// Reads a key/value parameter received on the command line.
 	const char *key = *argv, *value = *(argv + 1);
-	DeltaE(delimiter, d, state->params.delimiter = value);
+	DeltaE(accuracy, a, state->params.accuracy = value);
+	else DeltaE(checkpoint, k, state->params.checkpoint = value);
+	else DeltaE(delimiter, d, state->params.delimiter = value);
 	else DeltaE(generate, g, state->params.generate = strtoull(value, 0, 10));
+	else DeltaE(histogram, w, state->params.histogram = value);
 	else DeltaE(input-file, i, state->params.input_file = value);
+	else DeltaE(listen, l, state->params.listen = value);
 	else DeltaE(output-file, o, state->params.output_file = value);
 	else DeltaE(precision, p, state->params.precision = (int) strtol(value, 0, 10));
 	else DeltaE(rand-seed, r, state->params.seed = strtol(value, 0, 10));
+	else DeltaE(threads, j, state->params.threads = (int) strtol(value, 0, 10));
 	else DeltaE(tolerance, t, state->params.tolerance = strtod(value, 0));
 	else
 		return 0;
@@ -345,7 +443,12 @@ static int read_arg_1(const char **argv, state *state) {
 	// Reads a flag received on the command line.
 	const char *key = *argv;
 	DeltaE(canonical, c, state->params.canonical = 1);
+	else DeltaE(both, b, state->params.both = 1);
+	else DeltaE(components, m, state->params.components = 1);
 	else DeltaE(help, h, state->params.help = 1);
+	else DeltaE(group, u, state->params.group = 1);
+	else DeltaE(self-test, e, state->params.self_test = 1);
+	else DeltaE(no-self-test, n, state->params.no_self_test = 1);
 	else DeltaE(solve, s, state->params.mode = 's');
 	else DeltaE(verbose, v, state->params.verbose = 1);
 	else
@@ -371,7 +474,8 @@ static void open_descriptors(state *state) {
 		}
 	}
 	if (state->params.output_file) {
-		state->out_fp = fopen(state->params.output_file, "wb");
+		// A resumed job overwrites its output from the position saved in the checkpoint.
+		state->out_fp = fopen(state->params.output_file, state->progress.resumed ? "r+b" : "wb");
 		if (state->out_fp == 0) {
 			perror("Delta E 2000");
 			state->code = 3;
@@ -381,9 +485,9 @@ static void open_descriptors(state *state) {
 }
 
 static void close_descriptors(state *state) {
-	if (state->in_fp != stdin)
+	if (state->in_fp && state->in_fp != stdin)
 		fclose(state->in_fp);
-	if (state->out_fp != stdout)
+	if (state->out_fp && state->out_fp != stdout)
 		fclose(state->out_fp);
 }
 
@@ -419,6 +523,8 @@ static inline void rand_lab(double * restrict l, double * restrict a, double * r
 	perturb(b, -128.0, 128.0, x & 32767);
 }
 
+// FUZZER BEGIN : the implementations below, up to ciede_2000_components, are extracted up to FUZZER END.
+
 // The functional CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
 // "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
 static double ciede_2000_functional(const double l1, const double a1, const double b1, const double l2, const double a2, const double b2, const int canonical) {
@@ -627,6 +733,247 @@ static double ciede_2000_standard(const double l_1, const double a_1, const doub
 // CIE ΔE00 = 4.2960051327 (Gaurav Sharma, OpenJDK, ...)
 // Deviation between these two widely used variants ≈ 1.5e-5
 
+static double polynomial(const double *c, const int n, const double x) {
+	double r = c[n - 1];
+	for (int i = n - 2; 0 <= i; --i)
+		r = r * x + c[i];
+	return r;
+}
+
+static double atan2_tier(const double y, const double x, const tier *t) {
+	const double ax = fabs(x), ay = fabs(y), z = fmin(ax, ay) / fmax(fmax(ax, ay), 1e-30);
+	double r = z * polynomial(t->atan, t->n_atan, z * z);
+	if (ax < ay)
+		r = M_PI / 2.0 - r;
+	if (x < 0.0)
+		r = M_PI - r;
+	return y < 0.0 ? -r : r;
+}
+
+static double sin_tier(double x, const tier *t) {
+	x -= 2.0 * M_PI * floor(x / (2.0 * M_PI) + 0.5);
+	if (M_PI / 2.0 < x)
+		x = M_PI - x;
+	else if (x < -M_PI / 2.0)
+		x = -M_PI - x;
+	return x * polynomial(t->sin, t->n_sin, x * x);
+}
+
+static double exp_negative_tier(const double q, const tier *t) {
+	// exp(-q) = exp(-q / 32) ^ 32, and exp(-40) is negligible in the rotation term.
+	double r = polynomial(t->exp, t->n_exp, fmin(q, 40.0) / 32.0);
+	r *= r, r *= r, r *= r, r *= r;
+	return r * r;
+}
+
+// The ΔE2000 of an accuracy tier, evaluated in 64-bit so that the mean hue wraps as in ciede_2000_functional, and
+// whose deviation then stays within the contract of the tier.
+static double ciede_2000_tier(const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2, const int canonical, const tier *t) {
+	double n = (sqrt(a_1 * a_1 + b_1 * b_1) + sqrt(a_2 * a_2 + b_2 * b_2)) * 0.5;
+	n = n * n * n * n * n * n * n;
+	n = 1.0 + 0.5 * (1.0 - sqrt(n / (n + 6103515625.0)));
+	const double c_1 = sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const double c_2 = sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	double h_1 = atan2_tier(b_1, a_1 * n, t);
+	double h_2 = atan2_tier(b_2, a_2 * n, t);
+	h_1 += (h_1 < 0.0) * 2.0 * M_PI;
+	h_2 += (h_2 < 0.0) * 2.0 * M_PI;
+	n = fabs(h_2 - h_1);
+	const int wrap = 1e-14 < fabs(M_PI - n) && M_PI < n;
+	double h_m = (h_1 + h_2) * 0.5;
+	double h_d = (h_2 - h_1) * 0.5;
+	if (wrap) {
+		h_d += M_PI;
+		h_m += canonical && M_PI <= h_m ? -M_PI : M_PI;
+	}
+	const double p = 36.0 * h_m - 55.0 * M_PI;
+	n = (c_1 + c_2) * 0.5;
+	n = n * n * n * n * n * n * n;
+	const double r_t = -2.0 * sqrt(n / (n + 6103515625.0)) * sin_tier(M_PI / 3.0 * exp_negative_tier(p * p / (25.0 * M_PI * M_PI), t), t);
+	n = (l_1 + l_2) * 0.5;
+	n = (n - 50.0) * (n - 50.0);
+	const double l = (l_2 - l_1) / (1.0 + 0.015 * n / sqrt(20.0 + n));
+	const double h_t = 1.0	+ 0.24 * sin_tier(2.0 * h_m + M_PI / 2.0, t)
+				+ 0.32 * sin_tier(3.0 * h_m + 8.0 * M_PI / 15.0, t)
+				- 0.17 * sin_tier(h_m + M_PI / 3.0, t)
+				- 0.20 * sin_tier(4.0 * h_m + 3.0 * M_PI / 20.0, t);
+	n = c_1 + c_2;
+	const double h = 2.0 * sqrt(c_1 * c_2) * sin_tier(h_d, t) / (1.0 + 0.0075 * n * h_t);
+	const double c = (c_2 - c_1) / (1.0 + 0.0225 * n);
+	return sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+static double ciede_2000_accuracy(const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2, const int canonical, const tier *t) {
+	return t ? ciede_2000_tier(l_1, a_1, b_1, l_2, a_2, b_2, canonical, t) : ciede_2000_functional(l_1, a_1, b_1, l_2, a_2, b_2, canonical);
+}
+
+// The ΔE2000 in both conventions (option --both), as ciede_2000_functional gives them with canonical = 0 in
+// delta_e[0] and with canonical = 1 in delta_e[1]. The conventions only differ by the mean hue, when the hues
+// wrap and their raw mean is at least pi, so the terms depending on it are only evaluated twice in this case.
+static void ciede_2000_both(const double l1, const double a1, const double b1, const double l2, const double a2, const double b2, double *delta_e) {
+	const double k_L = 1.0;
+	const double k_C = 1.0;
+	const double k_H = 1.0;
+
+	const double pi_1 = 3.14159265358979323846;
+	const double pi_3 = 1.04719755119659774615;
+
+	const double c_orig_1 = sqrt(a1 * a1 + b1 * b1);
+	const double c_orig_2 = sqrt(a2 * a2 + b2 * b2);
+	const double c_avg = 0.5 * (c_orig_1 + c_orig_2);
+	const double c_avg_3 = c_avg * c_avg * c_avg;
+	const double c_avg_7 = c_avg_3 * c_avg_3 * c_avg;
+	const double g_factor = 1.0 + 0.5 * (1.0 - sqrt(c_avg_7 / (c_avg_7 + 6103515625.0)));
+
+	const double a1_prime = a1 * g_factor;
+	const double c1_prime = sqrt(a1_prime * a1_prime + b1 * b1);
+	const double a2_prime = a2 * g_factor;
+	const double c2_prime = sqrt(a2_prime * a2_prime + b2 * b2);
+
+	const double safe_1 = 1e30 * (double)(b1 == 0.0 && a1_prime == 0.0);
+	const double safe_2 = 1e30 * (double)(b2 == 0.0 && a2_prime == 0.0);
+	const double h1_raw = atan2(b1, a1_prime + safe_1);
+	const double h2_raw = atan2(b2, a2_prime + safe_2);
+	const double h1_adj = h1_raw + (double) (h1_raw < 0.0) * 2.0 * pi_1;
+	const double h2_adj = h2_raw + (double) (h2_raw < 0.0) * 2.0 * pi_1;
+	const double delta_h = fabs(h1_adj - h2_adj);
+	const double h_mean_raw = 0.5 * (h1_adj + h2_adj);
+	const double h_diff_raw = 0.5 * (h2_adj - h1_adj);
+
+	const double wrap_dist = fabs(pi_1 - delta_h);
+	const double hue_wrap = (double) (1e-14 < wrap_dist && pi_1 < delta_h);
+
+	// Bruce Lindbloom, Netflix’s VMAF, ... then Gaurav Sharma, OpenJDK, ...
+	const double h_mean_hi = (double) (hue_wrap && h_mean_raw < pi_1) * pi_1;
+	const double h_mean_lo = (double) (hue_wrap && h_mean_hi == 0.0) * pi_1;
+	const double h_mean[2] = {h_mean_raw + hue_wrap * pi_1, h_mean_raw + h_mean_hi - h_mean_lo};
+	const double h_diff = h_diff_raw + hue_wrap * pi_1;
+
+	// The terms that don't depend on the mean hue.
+	const double c_bar = 0.5 * (c1_prime + c2_prime);
+	const double c_bar_3 = c_bar * c_bar * c_bar;
+	const double c_bar_7 = c_bar_3 * c_bar_3 * c_bar;
+	const double R_C = sqrt(c_bar_7 / (c_bar_7 + 6103515625.0));
+
+	const double l_avg = 0.5 * (l1 + l2);
+	const double l_delta_sq = (l_avg - 50.0) * (l_avg - 50.0);
+	const double S_L = 1.0 + 0.015 * l_delta_sq / sqrt(20.0 + l_delta_sq);
+	const double L_term = (l2 - l1) / (k_L * S_L);
+
+	const double c_sum = c1_prime + c2_prime;
+	const double c_geo_mean = sqrt(c1_prime * c2_prime);
+	const double sin_h_diff = sin(h_diff);
+	const double C_term = (c2_prime - c1_prime) / (k_C * (1.0 + 0.0225 * c_sum));
+	const double L_part = L_term * L_term;
+	const double C_part = C_term * C_term;
+
+	for (int i = 0; i < 2; ++i) {
+		if (i == 1 && h_mean[1] == h_mean[0]) {
+			delta_e[1] = delta_e[0];
+			break;
+		}
+		const double theta = 36.0 * h_mean[i] - 55.0 * pi_1;
+		const double R_T = -2.0 * R_C * sin(pi_3 * exp(theta * theta / (-25.0 * pi_1 * pi_1)));
+		const double trig_1 = 0.17 * sin(h_mean[i] + pi_3);
+		const double trig_2 = 0.24 * sin(2.0 * h_mean[i] + 0.5 * pi_1);
+		const double trig_3 = 0.32 * sin(3.0 * h_mean[i] + 1.6  * pi_3);
+		const double trig_4 =  0.2 * sin(4.0 * h_mean[i] + 0.15 * pi_1);
+		const double T = 1.0 - trig_1 + trig_2 + trig_3 - trig_4;
+		const double H_term = 2.0 * c_geo_mean * sin_h_diff / (k_H * (1.0 + 0.0075 * c_sum * T));
+		const double H_part = H_term * H_term;
+		delta_e[i] = sqrt(L_part + C_part + H_part + C_term * H_term * R_T);
+	}
+}
+
+// The terms of the ΔE2000 (option --components) of a pair L1, a1, b1, L2, a2, b2, as 8 values : ΔL', ΔC', ΔH',
+// S_L, S_C, S_H, R_T and the ΔE2000, which is the one of ciede_2000_functional. These are the terms that the
+// functional implementation computes anyway, so that they cost no more than the ΔE2000 alone.
+#define N_COMPONENTS 8
+static void ciede_2000_components(const double l1, const double a1, const double b1, const double l2, const double a2, const double b2, const int canonical, double *terms) {
+	const double pi_1 = 3.14159265358979323846;
+	const double pi_3 = 1.04719755119659774615;
+
+	const double c_orig_1 = sqrt(a1 * a1 + b1 * b1);
+	const double c_orig_2 = sqrt(a2 * a2 + b2 * b2);
+	const double c_avg = 0.5 * (c_orig_1 + c_orig_2);
+	const double c_avg_3 = c_avg * c_avg * c_avg;
+	const double c_avg_7 = c_avg_3 * c_avg_3 * c_avg;
+	const double g_factor = 1.0 + 0.5 * (1.0 - sqrt(c_avg_7 / (c_avg_7 + 6103515625.0)));
+
+	const double a1_prime = a1 * g_factor;
+	const double c1_prime = sqrt(a1_prime * a1_prime + b1 * b1);
+	const double a2_prime = a2 * g_factor;
+	const double c2_prime = sqrt(a2_prime * a2_prime + b2 * b2);
+
+	const double safe_1 = 1e30 * (double)(b1 == 0.0 && a1_prime == 0.0);
+	const double safe_2 = 1e30 * (double)(b2 == 0.0 && a2_prime == 0.0);
+	const double h1_raw = atan2(b1, a1_prime + safe_1);
+	const double h2_raw = atan2(b2, a2_prime + safe_2);
+	const double h1_adj = h1_raw + (double) (h1_raw < 0.0) * 2.0 * pi_1;
+	const double h2_adj = h2_raw + (double) (h2_raw < 0.0) * 2.0 * pi_1;
+	const double delta_h = fabs(h1_adj - h2_adj);
+	const double h_mean_raw = 0.5 * (h1_adj + h2_adj);
+	const double h_diff_raw = 0.5 * (h2_adj - h1_adj);
+
+	const double wrap_dist = fabs(pi_1 - delta_h);
+	const double hue_wrap = (double) (1e-14 < wrap_dist && pi_1 < delta_h);
+	const double h_mean_hi = (double) (hue_wrap && h_mean_raw < pi_1) * pi_1;
+	const double h_mean_lo = (double) (hue_wrap && h_mean_hi == 0.0) * pi_1;
+	const double h_mean = canonical ? h_mean_raw + h_mean_hi - h_mean_lo : h_mean_raw + hue_wrap * pi_1;
+	const double h_diff = h_diff_raw + hue_wrap * pi_1;
+
+	const double c_bar = 0.5 * (c1_prime + c2_prime);
+	const double c_bar_3 = c_bar * c_bar * c_bar;
+	const double c_bar_7 = c_bar_3 * c_bar_3 * c_bar;
+	const double R_C = sqrt(c_bar_7 / (c_bar_7 + 6103515625.0));
+	const double theta = 36.0 * h_mean - 55.0 * pi_1;
+	const double R_T = -2.0 * R_C * sin(pi_3 * exp(theta * theta / (-25.0 * pi_1 * pi_1)));
+
+	const double l_avg = 0.5 * (l1 + l2);
+	const double l_delta_sq = (l_avg - 50.0) * (l_avg - 50.0);
+	const double l_delta = l2 - l1;
+	const double S_L = 1.0 + 0.015 * l_delta_sq / sqrt(20.0 + l_delta_sq);
+
+	const double trig_1 = 0.17 * sin(h_mean + pi_3);
+	const double trig_2 = 0.24 * sin(2.0 * h_mean + 0.5 * pi_1);
+	const double trig_3 = 0.32 * sin(3.0 * h_mean + 1.6  * pi_3);
+	const double trig_4 =  0.2 * sin(4.0 * h_mean + 0.15 * pi_1);
+	const double T = 1.0 - trig_1 + trig_2 + trig_3 - trig_4;
+
+	const double c_sum = c1_prime + c2_prime;
+	const double h_delta = 2.0 * sqrt(c1_prime * c2_prime) * sin(h_diff);
+	const double S_H = 1.0 + 0.0075 * c_sum * T;
+	const double c_delta = c2_prime - c1_prime;
+	const double S_C = 1.0 + 0.0225 * c_sum;
+
+	// The parametric factors k_L, k_C and k_H are 1.
+	const double L_term = l_delta / S_L;
+	const double C_term = c_delta / S_C;
+	const double H_term = h_delta / S_H;
+	terms[0] = l_delta, terms[1] = c_delta, terms[2] = h_delta;
+	terms[3] = S_L, terms[4] = S_C, terms[5] = S_H, terms[6] = R_T;
+	terms[7] = sqrt(L_term * L_term + C_term * C_term + H_term * H_term + C_term * H_term * R_T);
+}
+
+// FUZZER END
+
+// The values that solve appends, returning their count : the ΔE2000 in the convention of --canonical, in both
+// conventions with --both, or its N_COMPONENTS terms with --components.
+static int ciede_2000_solve(const state *state, const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2, double *values) {
+	if (state->params.components) {
+		ciede_2000_components(l_1, a_1, b_1, l_2, a_2, b_2, state->params.canonical, values);
+		return N_COMPONENTS;
+	}
+	if (!state->params.both)
+		values[0] = ciede_2000_accuracy(l_1, a_1, b_1, l_2, a_2, b_2, state->params.canonical, state->tier);
+	else if (state->tier) {
+		values[0] = ciede_2000_tier(l_1, a_1, b_1, l_2, a_2, b_2, 0, state->tier);
+		values[1] = ciede_2000_tier(l_1, a_1, b_1, l_2, a_2, b_2, 1, state->tier);
+	} else
+		ciede_2000_both(l_1, a_1, b_1, l_2, a_2, b_2, values);
+	return 1 + state->params.both;
+}
+
 static int ensure(const reference *r) {
 	const double delta_e_1 = ciede_2000_standard(r->l1, r->a1, r->b1, r->l2, r->a2, r->b2, r->compliance == CANONICAL);
 	const double delta_e_2 = ciede_2000_functional(r->l1, r->a1, r->b1, r->l2, r->a2, r->b2, r->compliance == CANONICAL);
@@ -648,6 +995,14 @@ static int static_controls(void) {
 		r_2.l2 = r_1->l1, r_2.a2 = r_1->a1, r_2.b2 = r_1->b1;
 		res &= ensure(r_1);
 		res &= ensure(&r_2);
+		for (size_t j = 0; j < sizeof(tiers) / sizeof(*tiers); ++j) {
+			const double delta_e_1 = ciede_2000_functional(r_1->l1, r_1->a1, r_1->b1, r_1->l2, r_1->a2, r_1->b2, r_1->compliance == CANONICAL);
+			const double delta_e_2 = ciede_2000_tier(r_1->l1, r_1->a1, r_1->b1, r_1->l2, r_1->a2, r_1->b2, r_1->compliance == CANONICAL, tiers + j);
+			if (tiers[j].contract < fabs(delta_e_1 - delta_e_2)) {
+				fprintf(stderr, "Test '%s' (%s accuracy) failed : got %g instead of %g\n", r_1->name, tiers[j].name, delta_e_2, delta_e_1);
+				res = 0;
+			}
+		}
 	}
 	return res;
 }
@@ -658,20 +1013,234 @@ static uint64_t get_time_ms(void) {
 	gettimeofday(&time, 0);
 	return (uint64_t) time.tv_sec * 1000 + (uint64_t) time.tv_usec / 1000;
 }
+
+static inline void sketch_add(sketch *k, const double x) {
+	// The exponent and the leading bits of the mantissa of x, shifted to start at 2^-64, give its bucket.
+	uint64_t bits;
+	memcpy(&bits, &x, sizeof(bits));
+	const int64_t i = (int64_t) (bits >> (52 - SKETCH_SUB_BITS)) - ((int64_t) (1023 - 64) << SKETCH_SUB_BITS);
+	++k->count[i < 0 ? 0 : SKETCH_BUCKETS <= i ? SKETCH_BUCKETS - 1 : i];
+	if (k->n++ == 0 || x < k->min)
+		k->min = x;
+	if (k->max < x)
+		k->max = x;
+}
+
+static void sketch_merge(sketch *k, const sketch *other) {
+	for (int i = 0; i < SKETCH_BUCKETS; ++i)
+		k->count[i] += other->count[i];
+	if (other->n && (k->n == 0 || other->min < k->min))
+		k->min = other->min;
+	if (other->n && (k->n == 0 || k->max < other->max))
+		k->max = other->max;
+	k->n += other->n;
+}
+
+static double sketch_bound(const int i) {
+	// The lower bound of the bucket i.
+	return ldexp(1.0 + (double) (i & ((1 << SKETCH_SUB_BITS) - 1)) / (1 << SKETCH_SUB_BITS), (i >> SKETCH_SUB_BITS) - 64);
+}
+
+static double sketch_quantile(const sketch *k, const double q) {
+	// The value of rank ⌈q * n⌉ is estimated by the middle of its bucket, within the observed range.
+	uint64_t rank = (uint64_t) ceil(q * (double) k->n), sum = 0;
+	rank += rank == 0;
+	for (int i = 0; i < SKETCH_BUCKETS; ++i)
+		if (rank <= (sum += k->count[i])) {
+			const double x = i == 0 ? k->min : (sketch_bound(i) + sketch_bound(i + 1)) * 0.5;
+			return x < k->min ? k->min : k->max < x ? k->max : x;
+		}
+	return k->max;
+}
+
+static void save_sketch(FILE *fp, const sketch *k) {
+	// One line holding the number of values, their range, then the non-empty buckets and their counts.
+	int n = 0;
+	for (int i = 0; i < SKETCH_BUCKETS; ++i)
+		n += k->count[i] != 0;
+	fprintf(fp, "%" PRIu64 " %a %a %d", k->n, k->min, k->max, n);
+	for (int i = 0; i < SKETCH_BUCKETS; ++i)
+		if (k->count[i])
+			fprintf(fp, " %d %" PRIu64, i, k->count[i]);
+	fputc('\n', fp);
+}
+
+static int load_sketch(FILE *fp, sketch *k) {
+	sketch *loaded = calloc(1, sizeof(*loaded));
+	int n, i, ok = loaded && fscanf(fp, "%" SCNu64 " %la %la %d", &loaded->n, &loaded->min, &loaded->max, &n) == 4;
+	uint64_t count;
+	for (; ok && 0 < n; --n)
+		if ((ok = fscanf(fp, "%d %" SCNu64, &i, &count) == 2 && 0 <= i && i < SKETCH_BUCKETS))
+			loaded->count[i] = count;
+	if (ok && fgetc(fp) == '\n') {
+		// The counts are restored by merging them into the empty sketch of the resumed job.
+		const uint64_t total = loaded->n;
+		loaded->n = 0;
+		for (i = 0; i < SKETCH_BUCKETS; ++i)
+			loaded->n += loaded->count[i];
+		ok = loaded->n == total;
+		if (ok)
+			sketch_merge(k, loaded);
+	} else
+		ok = 0;
+	free(loaded);
+	return ok;
+}
+
+static void print_quantiles(FILE *fp, const char *name, const sketch *k, const char *format) {
+	// The format applies to each of the 4 quantiles.
+	char line[255];
+	snprintf(line, sizeof(line), "%s : p50=%s  p90=%s  p99=%s  p99.9=%s\n", name, format, format, format, format);
+	fprintf(fp, line, sketch_quantile(k, 0.5), sketch_quantile(k, 0.9), sketch_quantile(k, 0.99), sketch_quantile(k, 0.999));
+}
+
+static void save_histogram(state *state) {
+	// The non-empty buckets of the distributions, as CSV, which can be merged across files by adding the counts.
+	FILE *fp = fopen(state->params.histogram, "wb");
+	const sketch *k[2] = {&state->delta_e, &state->deviation};
+	const char *name[2] = {"delta_e", "deviation"};
+	if (fp == 0) {
+		perror("Delta E 2000");
+		state->code = 3;
+		return;
+	}
+	fprintf(fp, "distribution,lower,upper,count\n");
+	for (int j = 0; j < 2; ++j)
+		for (int i = 0; i < SKETCH_BUCKETS; ++i)
+			if (k[j]->count[i])
+				fprintf(fp, "%s,%.17g,%.17g,%" PRIu64 "\n", name[j], i ? sketch_bound(i) : 0.0, sketch_bound(i + 1), k[j]->count[i]);
+	if (fclose(fp)) {
+		perror("Delta E 2000");
+		state->code = 3;
+	}
+}
+
+// The offsets of the files saved by a checkpoint exceed 2 GiB after a few dozen million lines, beyond the long of
+// ftell and fseek on Windows and the 32-bit systems.
+#if defined(_WIN32)
+typedef long long file_offset;
+#define DeltaE_tell _ftelli64
+#define DeltaE_seek _fseeki64
+#elif defined(__unix__) || defined(__APPLE__)
+typedef off_t file_offset;
+#define DeltaE_tell ftello
+#define DeltaE_seek fseeko
+#else
+typedef long file_offset;
+#define DeltaE_tell ftell
+#define DeltaE_seek fseek
+#endif
+
+static int tell_offset(FILE *fp, uint64_t *offset) {
+	const file_offset o = DeltaE_tell(fp);
+	*offset = o < 0 ? 0 : (uint64_t) o;
+	return 0 <= o;
+}
+
+static int seek_offset(FILE *fp, const uint64_t offset) {
+	// An offset that the platform can't represent is rejected, rather than truncated.
+	const file_offset o = (file_offset) offset;
+	return 0 <= o && (uint64_t) o == offset && DeltaE_seek(fp, o, SEEK_SET) == 0;
+}
+
+static char job_mode(const state *state) {
+	return state->params.generate ? 'g' : state->params.mode == 's' ? 's' : 'c';
+}
+
+static void save_checkpoint(state *state) {
+	// The checkpoint is written to a temporary file then renamed, so an interruption never leaves it incomplete.
+	char path[1024];
+	progress *p = &state->progress;
+	FILE *fp;
+	fflush(state->out_fp);
+	p->input_offset = p->output_offset = 0;
+	if ((state->params.input_file && !tell_offset(state->in_fp, &p->input_offset)) || (state->params.output_file && !tell_offset(state->out_fp, &p->output_offset))) {
+		perror("Delta E 2000");
+		state->checkpoint_time = get_time_ms();
+		return;
+	}
+	p->elapsed_ms = state->time_1 ? get_time_ms() - state->time_1 : 0;
+	snprintf(path, sizeof(path), "%s.tmp", state->params.checkpoint);
+	fp = fopen(path, "wb");
+	if (fp) {
+		fprintf(fp, "Delta E 2000 checkpoint %c %" PRIu64 " %" PRIu64 " %d %c\n", job_mode(state), state->params.generate, state->params.seed, state->params.both ? 2 : state->params.canonical, state->tier ? *state->tier->name : 'e');
+		fprintf(fp, "%" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64, p->input_offset, p->output_offset, p->seed, p->index, p->n_lines);
+		fprintf(fp, " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %d", p->n_errors, p->n_successes, p->errors_displayed, p->elapsed_ms, p->do_copy);
+		fprintf(fp, " %" PRIu64 " %" PRIu64 "\n", p->n_default, p->n_canonical);
+		fprintf(fp, "%a %a %a\n", p->max_error, p->sum_errors, p->sum_delta_e);
+		save_sketch(fp, &state->delta_e);
+		save_sketch(fp, &state->deviation);
+		fprintf(fp, "%s", state->buf_2);
+		// The renaming doesn't replace an existing file on every platform.
+		if (fclose(fp) == 0 && rename(path, state->params.checkpoint) && (remove(state->params.checkpoint) || rename(path, state->params.checkpoint)))
+			perror("Delta E 2000");
+	} else
+		perror("Delta E 2000");
+	state->checkpoint_time = get_time_ms();
+}
+
+static void load_checkpoint(state *state) {
+	// Without a checkpoint file the job starts normally, it resumes when the file belongs to the same job.
+	FILE *fp = fopen(state->params.checkpoint, "rb");
+	progress *p = &state->progress;
+	uint64_t generate, seed;
+	int canonical, ok;
+	char mode, accuracy;
+	if (fp == 0)
+		return;
+	ok = fscanf(fp, "Delta E 2000 checkpoint %c %" SCNu64 " %" SCNu64 " %d %c", &mode, &generate, &seed, &canonical, &accuracy) == 5;
+	ok = ok && mode == job_mode(state) && generate == state->params.generate && canonical == (state->params.both ? 2 : state->params.canonical);
+	ok = ok && accuracy == (state->tier ? *state->tier->name : 'e');
+	ok = ok && (state->params.seed == 0 || state->params.seed == seed);
+	ok = ok && fscanf(fp, "%" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64, &p->input_offset, &p->output_offset, &p->seed, &p->index, &p->n_lines) == 5;
+	ok = ok && fscanf(fp, "%" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %d", &p->n_errors, &p->n_successes, &p->errors_displayed, &p->elapsed_ms, &p->do_copy) == 5;
+	ok = ok && fscanf(fp, "%" SCNu64 " %" SCNu64, &p->n_default, &p->n_canonical) == 2;
+	ok = ok && fscanf(fp, "%la %la %la", &p->max_error, &p->sum_errors, &p->sum_delta_e) == 3 && fgetc(fp) == '\n';
+	ok = ok && load_sketch(fp, &state->delta_e) && load_sketch(fp, &state->deviation);
+	if (ok && fgets(state->buf_2, sizeof(state->buf_2) / sizeof(*state->buf_2) - 1, fp) == 0)
+		*state->buf_2 = 0;
+	fclose(fp);
+	if (ok) {
+		state->params.seed = seed;
+		p->resumed = 1;
+	} else {
+		fprintf(stderr, "Delta E 2000: The checkpoint '%s' belongs to another job.\n", state->params.checkpoint);
+		state->code = 2;
+	}
+}
+
+static void resume_checkpoint(state *state) {
+	const progress *p = &state->progress;
+	if ((state->params.input_file && !seek_offset(state->in_fp, p->input_offset)) || (state->params.output_file && !seek_offset(state->out_fp, p->output_offset))) {
+		fprintf(stderr, "Delta E 2000: The files can't be positioned at the offsets of the checkpoint '%s'.\n", state->params.checkpoint);
+		state->code = 3;
+	} else if (state->params.verbose)
+		fprintf(stderr, "Resuming from '%s' after %" PRIu64 " lines.\n", state->params.checkpoint, job_mode(state) == 'g' ? p->index : p->n_lines);
+}
+
+// The time elapsed since the last checkpoint is checked every 65536 lines.
+#define DeltaE_checkpoint(state, line) \
+	if ((state)->params.checkpoint && !((line) & 65535) && 10000 <= get_time_ms() - (state)->checkpoint_time) \
+		save_checkpoint(state)
 #define Precision "%.15g"
 #define DeltaE_default(a, b) ((a) <= 0 ? (b) : (a))
 static void generate(state *state) {
-	const uint64_t time_1 = get_time_ms();
+	const uint64_t time_1 = state->time_1 = get_time_ms() - state->progress.elapsed_ms;
 	if (state->params.seed == 0)
 		state->params.seed = time_1;
 	uint64_t seed = state->params.seed ^ 0x2236b69a7d223bd;
 	for (uint64_t i = 0, j = seed + (seed == 0); xor_random(&j), i < 64; ++i)
 		seed ^= (j & 1) << i;
-	const int number = (int)DeltaE_default(state->params.generate, 10);
+	if (state->progress.resumed)
+		seed = state->progress.seed;
+	const uint64_t number = DeltaE_default(state->params.generate, 10);
 	const char s = (char) (state->params.delimiter ? DeltaE_default(*state->params.delimiter, ',') : ',');
 	sprintf(state->format, "%" Precision "%c%" Precision "%c%" Precision "%c%" Precision "%c%" Precision "%c%" Precision "\n", s, s, s, s, s);
 	double l_1, a_1, b_1, l_2, a_2, b_2;
-	for (int i = (sizeof(references) / sizeof(*references)) << 1; i < number; ++i) {
+	for (uint64_t i = state->progress.resumed ? state->progress.index : (sizeof(references) / sizeof(*references)) << 1; i < number; ++i) {
+		state->progress.seed = seed;
+		state->progress.index = i;
+		DeltaE_checkpoint(state, i);
 		rand_lab(&l_1, &a_1, &b_1, &seed);
 		rand_lab(&l_2, &a_2, &b_2, &seed);
 		fprintf(state->out_fp, state->format, l_1, a_1, b_1, l_2, a_2, b_2);
@@ -689,17 +1258,156 @@ static void generate(state *state) {
 		fprintf(state->out_fp, "%.04f%c%.04f%c%.04f%c%.04f%c%.04f%c%.04f\n", r->l1, s, r->a1, s, r->b1, s, r->l2, s, r->a2, s, r->b2);
 		fprintf(state->out_fp, "%.04f%c%.04f%c%.04f%c%.04f%c%.04f%c%.04f\n", r->l2, s, r->a2, s, r->b2, s, r->l1, s, r->a1, s, r->b1);
 	}
-	fprintf(stderr, "Generated %d test cases in %.2f s using seed %" PRIu64 ".\n", number, (double) (get_time_ms() - time_1) / 1000.0, state->params.seed);
+	fprintf(stderr, "Generated %" PRIu64 " test cases in %.2f s using seed %" PRIu64 ".\n", number, (double) (get_time_ms() - time_1) / 1000.0, state->params.seed);
 }
 #undef Precision
 
+// With --group, solve reads the lines by blocks, and buckets the rows by the text of their first L*a*b* triple
+// (the standard), which is then parsed once per bucket, the results being written back in the order of the
+// lines, so that the output is the same as without. Only the parsing is shared : the G factor mixes the chromas
+// of both colors into C' and h', so no term of the ΔE2000 but the chroma C* depends on the standard alone.
+#define GROUP_LINES 4096
+#define GROUP_SLOTS 8192
+
+typedef struct {
+	char (*text)[255];
+	char (*tokens)[255];
+	double (*sample)[3];
+	double (*delta_e)[N_COMPONENTS];
+	int *bucket;
+	int *order;
+	// For each bucket : its key (the text of the standard in the tokens of its first row), and its standard.
+	const char **key;
+	size_t *key_len;
+	uint64_t *hash;
+	double (*standard)[3];
+	int *start;
+	int slots[GROUP_SLOTS];
+	int n_block_buckets;
+	uint64_t n_rows;
+	uint64_t n_buckets;
+} groups;
+
+static uint64_t hash_text(const char *begin, const char *end) {
+	// FNV-1a, enough to spread the keys over the slots, which then compare the texts.
+	uint64_t h = 0xcbf29ce484222325;
+	while (begin < end)
+		h = (h ^ (unsigned char) *begin++) * 0x100000001b3;
+	return h;
+}
+
+static int read_group(state *state, groups *g, const char *s) {
+	// Reads a block of lines, and assigns the valid ones to the bucket of their standard (-1 otherwise).
+	int n = 0, n_buckets = 0;
+	for (int i = 0; i < GROUP_SLOTS; ++i)
+		g->slots[i] = -1;
+	while (n < GROUP_LINES && fgets(g->text[n], sizeof(*g->text) - 1, state->in_fp)) {
+		char *pos = strrchr(g->text[n], '\n');
+		if (pos)
+			*(pos - (pos != g->text[n] && *(pos - 1) == '\r')) = 0;
+		strcpy(g->tokens[n], g->text[n]);
+		g->bucket[n] = -1;
+		const char *t_1 = strtok(g->tokens[n], s), *t_2 = strtok(0, s), *t_3 = strtok(0, s);
+		const char *t_4 = strtok(0, s), *t_5 = strtok(0, s), *t_6 = strtok(0, "\r\n");
+		if (t_1 && t_2 && t_3 && t_4 && t_5 && t_6) {
+			double *x = g->sample[n];
+			x[0] = strtod(t_4, 0), x[1] = strtod(t_5, 0), x[2] = strtod(t_6, 0);
+			// The key spans the text of the standard, from its first character to the end of its b*.
+			const char *end = t_3 + strlen(t_3);
+			const size_t len = (size_t) (end - t_1);
+			const uint64_t h = hash_text(t_1, end);
+			int slot = (int) (h & (GROUP_SLOTS - 1)), b;
+			for (; (b = g->slots[slot]) != -1; slot = (slot + 1) & (GROUP_SLOTS - 1))
+				if (g->hash[b] == h && g->key_len[b] == len && !memcmp(g->key[b], t_1, len))
+					break;
+			if (b == -1) {
+				b = g->slots[slot] = n_buckets++;
+				g->key[b] = t_1, g->key_len[b] = len, g->hash[b] = h;
+				g->standard[b][0] = strtod(t_1, 0), g->standard[b][1] = strtod(t_2, 0), g->standard[b][2] = strtod(t_3, 0);
+			}
+			const double *y = g->standard[b];
+			if (isfinite(y[0]) && isfinite(y[1]) && isfinite(y[2]) && isfinite(x[0]) && isfinite(x[1]) && isfinite(x[2]))
+				g->bucket[n] = b, ++g->n_rows;
+		}
+		++n;
+	}
+	// A counting sort lists the rows of each bucket contiguously.
+	for (int b = 0; b <= n_buckets; ++b)
+		g->start[b] = 0;
+	for (int i = 0; i < n; ++i)
+		if (g->bucket[i] != -1)
+			++g->start[g->bucket[i] + 1];
+	for (int b = 0; b < n_buckets; ++b)
+		g->start[b + 1] += g->start[b];
+	for (int i = 0; i < n; ++i)
+		if (g->bucket[i] != -1)
+			g->order[g->start[g->bucket[i]]++] = i;
+	for (int b = n_buckets; 0 < b; --b)
+		g->start[b] = g->start[b - 1];
+	g->start[0] = 0;
+	g->n_block_buckets = n_buckets;
+	g->n_buckets += (uint64_t) n_buckets;
+	return n;
+}
+
+static void solve_grouped(state *state, const char *s) {
+	groups g = {0};
+	g.text = malloc(GROUP_LINES * sizeof(*g.text));
+	g.tokens = malloc(GROUP_LINES * sizeof(*g.tokens));
+	g.sample = malloc(GROUP_LINES * sizeof(*g.sample));
+	g.delta_e = malloc(GROUP_LINES * sizeof(*g.delta_e));
+	g.bucket = malloc(GROUP_LINES * sizeof(*g.bucket));
+	g.order = malloc(GROUP_LINES * sizeof(*g.order));
+	g.key = malloc(GROUP_LINES * sizeof(*g.key));
+	g.key_len = malloc(GROUP_LINES * sizeof(*g.key_len));
+	g.hash = malloc(GROUP_LINES * sizeof(*g.hash));
+	g.standard = malloc(GROUP_LINES * sizeof(*g.standard));
+	g.start = malloc((GROUP_LINES + 1) * sizeof(*g.start));
+	if (g.text && g.tokens && g.sample && g.delta_e && g.bucket && g.order && g.key && g.key_len && g.hash && g.standard && g.start)
+		for (int n; (n = read_group(state, &g, s)) != 0;) {
+			for (int b = 0; b < g.n_block_buckets; ++b) {
+				const double *y = g.standard[b];
+				for (int k = g.start[b]; k < g.start[b + 1]; ++k) {
+					const double *x = g.sample[g.order[k]];
+					ciede_2000_solve(state, y[0], y[1], y[2], x[0], x[1], x[2], g.delta_e[g.order[k]]);
+				}
+			}
+			for (int i = 0; i < n; ++i) {
+				fprintf(state->out_fp, "%s", g.text[i]);
+				if (g.bucket[i] == -1)
+					fputc('\n', state->out_fp);
+				else {
+					const double *v = g.delta_e[i];
+					fprintf(state->out_fp, state->format, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+					sketch_add(&state->delta_e, v[state->params.components ? N_COMPONENTS - 1 : 0]);
+				}
+			}
+			// The blocks being of 4096 lines, a checkpoint always falls between two blocks.
+			state->progress.n_lines += (uint64_t) n;
+			DeltaE_checkpoint(state, state->progress.n_lines);
+		}
+	else {
+		perror("Delta E 2000");
+		state->code = 4;
+	}
+	if (state->params.verbose && g.n_rows)
+		fprintf(stderr, "Grouped %" PRIu64 " rows under %" PRIu64 " standards (%.2f rows per standard).\n", g.n_rows, g.n_buckets, (double) g.n_rows / (double) g.n_buckets);
+	free(g.text), free(g.tokens), free(g.sample), free(g.delta_e), free(g.bucket), free(g.order);
+	free(g.key), free(g.key_len), free(g.hash), free(g.standard), free(g.start);
+}
+
 static void solve(state *state) {
 	char s[2] = {0};
-	const uint64_t time_1 = get_time_ms();
+	const uint64_t time_1 = state->time_1 = get_time_ms() - state->progress.elapsed_ms;
 	const int p = state->params.precision, q = p < 1 || 15 < p ? 15 : p;
 	s[0] = (char) (state->params.delimiter ? DeltaE_default(*state->params.delimiter, ',') : ',');
-	sprintf(state->format, "%s%%.%df\n", s, q);
-	while (fgets(state->buf_1, sizeof(state->buf_1) / sizeof(*state->buf_1) - 1, state->in_fp)) {
+	char *f = state->format;
+	for (int i = 0, n = state->params.components ? N_COMPONENTS : 1 + state->params.both; i < n; ++i)
+		f += sprintf(f, "%s%%.%df", s, q);
+	strcpy(f, "\n");
+	if (state->params.group)
+		solve_grouped(state, s);
+	else while (fgets(state->buf_1, sizeof(state->buf_1) / sizeof(*state->buf_1) - 1, state->in_fp)) {
 		char *pos = strrchr(state->buf_1, '\n');
 		*(pos - (pos != state->buf_1 && *(pos - 1) == '\r')) = 0;
 		fprintf(state->out_fp, "%s", state->buf_1);
@@ -710,27 +1418,38 @@ static void solve(state *state) {
 			const double l_2 = strtod(t_4, 0), a_2 = strtod(t_5, 0), b_2 = strtod(t_6, 0);
 			if (isfinite(l_1) && isfinite(a_1) && isfinite(b_1) && isfinite(l_2) && isfinite(a_2) && isfinite(b_2)) {
 				// Solving the ΔE2000 could also be done with the standard implementation, but is done with the functional implementation
-				const double delta_e = ciede_2000_functional(l_1, a_1, b_1, l_2, a_2, b_2, state->params.canonical);
-				fprintf(state->out_fp, state->format, delta_e);
+				double v[N_COMPONENTS] = {0};
+				ciede_2000_solve(state, l_1, a_1, b_1, l_2, a_2, b_2, v);
+				fprintf(state->out_fp, state->format, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+				sketch_add(&state->delta_e, v[state->params.components ? N_COMPONENTS - 1 : 0]);
 			} else
 				fputc('\n', state->out_fp);
 		} else
 			fputc('\n', state->out_fp);
+		DeltaE_checkpoint(state, ++state->progress.n_lines);
 	}
-	if (state->params.verbose)
+	if (state->params.verbose) {
 		fprintf(stderr, "Solved in %.2f s.\n", (double) (get_time_ms() - time_1) / 1000.0);
+		if (state->delta_e.n)
+			print_quantiles(stderr, "Delta E", &state->delta_e, "%.4f");
+	}
 }
 
 static void control(state *state) {
 	char s[2] = {0};
-	uint64_t time_1 = 0;
-	const double t = state->params.tolerance, tolerance = t < 0.0 ? 0.0 : 10.0 < t ? 10.0 : t;
+	progress *p = &state->progress;
+	const double t = state->params.tolerance, u = t < 0.0 ? 0.0 : 10.0 < t ? 10.0 : t;
+	// The ΔE2000 of an accuracy tier are verified against the exact ones, within the contract of the tier.
+	const double tolerance = state->tier && u < state->tier->contract ? state->tier->contract : u;
 	s[0] = (char) (state->params.delimiter ? DeltaE_default(*state->params.delimiter, ',') : ',');
-	int do_copy = 1, n_lines = 0, n_errors = 0, n_successes = 0, errors_displayed = 0, has_new_error;
-	double max_error = 0.0, sum_errors = 0.0, sum_delta_e = 0.0;
+	int has_new_error;
+	if (p->resumed)
+		state->time_1 = p->do_copy ? 0 : get_time_ms() - p->elapsed_ms;
+	else
+		p->do_copy = 1;
 	while (fgets(state->buf_1, sizeof(state->buf_1) / sizeof(*state->buf_1) - 1, state->in_fp)) {
-		++n_lines;
-		if (do_copy)
+		++p->n_lines;
+		if (p->do_copy)
 			strcpy(state->buf_2, state->buf_1);
 		const char *t_1 = strtok(state->buf_1, s), *t_2 = strtok(0, s), *t_3 = strtok(0, s);
 		const char *t_4 = strtok(0, s), *t_5 = strtok(0, s), *t_6 = strtok(0, s), *t_7 = strtok(0, "\r\n");
@@ -740,44 +1459,473 @@ static void control(state *state) {
 			const double delta_e = strtod(t_7, 0);
 			if (isfinite(l_1) && isfinite(a_1) && isfinite(b_1) && isfinite(l_2) && isfinite(a_2) && isfinite(b_2) && isfinite(delta_e)) {
 				// Checking the ΔE2000 could also be done with the standard implementation, but is done with the functional implementation
-				const double expected_delta_e = ciede_2000_functional(l_1, a_1, b_1, l_2, a_2, b_2, state->params.canonical);
+				double expected_delta_e;
+				if (state->params.both) {
+					// The line is checked against the closer of the two conventions, which it tells apart when they
+					// differ by more than the tolerance.
+					double both[2];
+					ciede_2000_both(l_1, a_1, b_1, l_2, a_2, b_2, both);
+					const double error_0 = fabs(both[0] - delta_e), error_1 = fabs(both[1] - delta_e);
+					const int distinct = tolerance < fabs(both[0] - both[1]);
+					p->n_default += distinct && error_0 < error_1;
+					p->n_canonical += distinct && error_1 < error_0;
+					expected_delta_e = error_1 < error_0 ? both[1] : both[0];
+				} else
+					expected_delta_e = ciede_2000_functional(l_1, a_1, b_1, l_2, a_2, b_2, state->params.canonical);
 				const double error = fabs(expected_delta_e - delta_e);
-				sum_delta_e += expected_delta_e;
-				sum_errors += error;
-				has_new_error = max_error < error;
+				p->sum_delta_e += expected_delta_e;
+				p->sum_errors += error;
+				sketch_add(&state->delta_e, expected_delta_e);
+				sketch_add(&state->deviation, error);
+				has_new_error = p->max_error < error;
 				if (has_new_error)
-					max_error = error;
+					p->max_error = error;
 				if (tolerance < error) {
-					++n_errors;
-					if (has_new_error && ++errors_displayed <= 5) {
-						fprintf(stderr, "Line %-4d : L1=%.17g a1=%.17g b1=%.17g\n", n_lines, l_1, a_1, b_1);
+					++p->n_errors;
+					if (has_new_error && ++p->errors_displayed <= 5) {
+						fprintf(stderr, "Line %-4" PRIu64 " : L1=%.17g a1=%.17g b1=%.17g\n", p->n_lines, l_1, a_1, b_1);
 						fprintf(stderr, "            L2=%.17g a2=%.17g b2=%.17g\n", l_2, a_2, b_2);
 						fprintf(stderr, "Expecting : %.17f       Found deviation : %.3g\n", expected_delta_e, error);
 						fprintf(stderr, "      Got : %.17f\n\n", delta_e);
 					}
 				} else
-					++n_successes;
-				if (do_copy) {
-					do_copy = 0;
-					time_1 = get_time_ms();
+					++p->n_successes;
+				if (p->do_copy) {
+					p->do_copy = 0;
+					state->time_1 = get_time_ms();
 				}
 			}
 		}
+		DeltaE_checkpoint(state, p->n_lines);
 	}
-	if (n_successes || n_errors) {
+	if (p->n_successes || p->n_errors) {
 		fprintf(state->out_fp, "CIEDE2000 Verification Summary :\n");
 		fprintf(state->out_fp, "  First Verified Line : %s", state->buf_2);
-		fprintf(state->out_fp, "             Duration : %.02f s\n", (double) (get_time_ms() - time_1) / 1000.0);
-		fprintf(state->out_fp, "            Successes : %d\n", n_successes);
-		fprintf(state->out_fp, "               Errors : %d\n", n_errors);
-		fprintf(state->out_fp, "      Average Delta E : %.4f\n", sum_delta_e / (n_successes + n_errors));
-		fprintf(state->out_fp, "    Average Deviation : %.1e\n", sum_errors / (n_successes + n_errors));
-		fprintf(state->out_fp, "    Maximum Deviation : %.1e\n\n", max_error);
+		fprintf(state->out_fp, "             Duration : %.02f s\n", (double) (get_time_ms() - state->time_1) / 1000.0);
+		fprintf(state->out_fp, "            Successes : %" PRIu64 "\n", p->n_successes);
+		fprintf(state->out_fp, "               Errors : %" PRIu64 "\n", p->n_errors);
+		fprintf(state->out_fp, "      Average Delta E : %.4f\n", p->sum_delta_e / (double) (p->n_successes + p->n_errors));
+		fprintf(state->out_fp, "    Average Deviation : %.1e\n", p->sum_errors / (double) (p->n_successes + p->n_errors));
+		fprintf(state->out_fp, "    Maximum Deviation : %.1e\n", p->max_error);
+		if (state->params.both) {
+			fprintf(state->out_fp, "    Closer to Default : %" PRIu64 "\n", p->n_default);
+			fprintf(state->out_fp, "  Closer to Canonical : %" PRIu64 "\n", p->n_canonical);
+		}
+		print_quantiles(state->out_fp, "    Delta E Quantiles", &state->delta_e, "%.4f");
+		print_quantiles(state->out_fp, "  Deviation Quantiles", &state->deviation, "%.1e");
+		fputc('\n', state->out_fp);
 	} else
 		fprintf(stderr, "No data to verify.\n");
 }
+#undef DeltaE_checkpoint
 #undef DeltaE_default
 
+#ifdef DELTAE_SERVER
+// The server mode (option --listen) answers the requests of long-running services over a Unix socket, sparing
+// them a process, the static controls and the CSV conversions per job. Each request and each response is a
+// header followed by a body, in the byte order of the host, since the socket is local :
+// - uint32 size : the number of bytes of the body
+// - uint16 op : 1 solve, 2 one-to-many, 3 control, 4 statistics, 5 shutdown, 6 components (echoed by the response)
+// - uint16 flags : 1 for the canonical hue mean in the request, 0 for success or 1 for a bad request in the response
+// - uint32 id : chosen by the client, and echoed by the response
+// - uint32 count : the number of pairs (of colors in one-to-many, of bytes in the statistics response)
+// The bodies, made of doubles, are :
+// - solve : count pairs L1, a1, b1, L2, a2, b2, answered by count ΔE2000
+// - one-to-many : a standard L, a, b then count samples L, a, b, answered by count ΔE2000
+// - control : a tolerance, then count pairs L1, a1, b1, L2, a2, b2, ΔE2000 to check, answered by the number of
+//   errors and the index of the maximum deviation (two uint64), then the maximum deviation
+// - statistics : empty, answered by the text of the latency quantiles of each operation, in microseconds
+// - shutdown : empty, answered by an empty body, after which the server stops
+// - components : count pairs L1, a1, b1, L2, a2, b2, answered by count rows of the 8 values of ciede_2000_components
+// A pool of workers serves the connections, a connection at a time each, reusing their buffers. A client can
+// send many requests without waiting for the responses, which are then written together.
+#define SERVER_OPS 7
+#define SERVER_QUEUE 1024
+#define SERVER_MAX_BODY (64 << 20)
+
+typedef struct {
+	uint32_t size;
+	uint16_t op;
+	uint16_t flags;
+	uint32_t id;
+	uint32_t count;
+} server_header;
+
+typedef struct {
+	uint16_t op;
+	uint64_t time_ns;
+} server_pending;
+
+typedef struct server server;
+
+typedef struct {
+	server *s;
+	pthread_t thread;
+	pthread_mutex_t lock; // Guards the latencies, which the statistics requests of other workers read.
+	sketch latency[SERVER_OPS];
+	int fd; // The connection being served, or -1.
+	char *in;
+	char *out;
+	server_pending *pending;
+	size_t in_size;
+	size_t out_size;
+	size_t pending_size;
+} server_worker;
+
+struct server {
+	const state *state;
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+	int queue[SERVER_QUEUE];
+	int head;
+	int n_queued;
+	int n_workers;
+	int stop;
+	server_worker *workers;
+};
+
+static const char *server_ops[SERVER_OPS] = {0, "Solve", "One-to-many", "Control", "Statistics", "Shutdown", "Components"};
+static volatile sig_atomic_t server_signal;
+
+static void server_on_signal(int signal) {
+	server_signal = signal;
+}
+
+static uint64_t get_time_ns(void) {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t) time.tv_sec * 1000000000 + (uint64_t) time.tv_nsec;
+}
+
+static int reserve(void *buffer, size_t *size, const size_t wanted) {
+	// Grows a pooled buffer to at least the wanted size, which it then keeps for the next requests.
+	if (wanted <= *size)
+		return 1;
+	size_t n = *size ? *size : 4096;
+	while (n < wanted)
+		n *= 2;
+	void *p;
+	memcpy(&p, buffer, sizeof(p));
+	if ((p = realloc(p, n)))
+		memcpy(buffer, &p, sizeof(p)), *size = n;
+	return p != 0;
+}
+
+static int write_all(const int fd, const char *data, size_t n) {
+	for (ssize_t m; n; data += m, n -= (size_t) m)
+		if ((m = write(fd, data, n)) < 0 && errno != EINTR)
+			return 0;
+		else if (m < 0)
+			m = 0;
+	return 1;
+}
+
+static void server_statistics(server *s, char **text, size_t *len) {
+	// The latencies of all the workers, merged for each operation.
+	sketch *k = calloc(1, sizeof(*k));
+	FILE *fp = open_memstream(text, len);
+	if (k && fp) {
+		for (int op = 1; op < SERVER_OPS; ++op) {
+			char name[64], label[64];
+			memset(k, 0, sizeof(*k));
+			for (int i = 0; i < s->n_workers; ++i) {
+				pthread_mutex_lock(&s->workers[i].lock);
+				sketch_merge(k, s->workers[i].latency + op);
+				pthread_mutex_unlock(&s->workers[i].lock);
+			}
+			if (k->n) {
+				snprintf(name, sizeof(name), "%s Requests", server_ops[op]);
+				fprintf(fp, "%21s : %" PRIu64 "\n", name, k->n);
+				snprintf(name, sizeof(name), "%s Latency", server_ops[op]);
+				snprintf(label, sizeof(label), "%21s", name);
+				print_quantiles(fp, label, k, "%.1fus");
+			}
+		}
+	}
+	if (fp)
+		fclose(fp);
+	else
+		*text = 0, *len = 0;
+	free(k);
+}
+
+static void server_stop(server *s) {
+	// Stops the workers and the loop accepting the connections, which a connection wakes up.
+	struct sockaddr_un address = {0};
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	pthread_mutex_lock(&s->lock);
+	s->stop = 1;
+	pthread_cond_broadcast(&s->changed);
+	for (int i = 0; i < s->n_workers; ++i)
+		if (s->workers[i].fd != -1)
+			shutdown(s->workers[i].fd, SHUT_RDWR);
+	pthread_mutex_unlock(&s->lock);
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, s->state->params.listen, sizeof(address.sun_path) - 1);
+	if (fd != -1) {
+		connect(fd, (struct sockaddr *) &address, sizeof(address));
+		close(fd);
+	}
+}
+
+static int server_answer(server_worker *w, const server_header *h, const char *body, size_t *out_len) {
+	// Appends the response of a request to the output buffer, and returns 0 when the server must stop.
+	const state *state = w->s->state;
+	const int canonical = state->params.canonical || (h->flags & 1);
+	const uint64_t n = h->count;
+	const uint64_t expected = h->op == 1 || h->op == 6 ? 48 * n : h->op == 2 ? 24 + 24 * n : h->op == 3 ? 8 + 56 * n : 0;
+	server_header r = *h;
+	double x[7];
+	char *text = 0;
+	size_t len = 0;
+	r.flags = 0, r.size = 0;
+	if (h->op < 1 || SERVER_OPS <= h->op || expected != h->size)
+		r.flags = 1, r.count = 0;
+	else if (h->op == 4) {
+		server_statistics(w->s, &text, &len);
+		r.size = r.count = (uint32_t) len;
+	} else
+		r.size = h->op == 3 ? 24 : h->op == 5 ? 0 : h->op == 6 ? (uint32_t) (8 * N_COMPONENTS * n) : (uint32_t) (8 * n);
+	if (!reserve(&w->out, &w->out_size, *out_len + sizeof(r) + r.size)) {
+		free(text);
+		return 0;
+	}
+	char *out = w->out + *out_len;
+	memcpy(out, &r, sizeof(r));
+	out += sizeof(r);
+	*out_len += sizeof(r) + r.size;
+	if (r.flags == 0 && h->op == 1)
+		for (uint64_t i = 0; i < n; ++i, body += 48, out += 8) {
+			memcpy(x, body, 48);
+			x[6] = ciede_2000_accuracy(x[0], x[1], x[2], x[3], x[4], x[5], canonical, state->tier);
+			memcpy(out, x + 6, 8);
+		}
+	else if (r.flags == 0 && h->op == 2) {
+		double y[3];
+		memcpy(y, body, 24);
+		for (uint64_t i = 0; i < n; ++i, out += 8) {
+			memcpy(x, body + 24 + 24 * i, 24);
+			x[6] = ciede_2000_accuracy(y[0], y[1], y[2], x[0], x[1], x[2], canonical, state->tier);
+			memcpy(out, x + 6, 8);
+		}
+	} else if (r.flags == 0 && h->op == 3) {
+		// As in control, the contract of the accuracy tier raises the tolerance.
+		double t, max_error = 0.0;
+		uint64_t result[2] = {0, 0};
+		memcpy(&t, body, 8);
+		if (state->tier && t < state->tier->contract)
+			t = state->tier->contract;
+		for (uint64_t i = 0; i < n; ++i) {
+			memcpy(x, body + 8 + 56 * i, 56);
+			const double error = fabs(ciede_2000_functional(x[0], x[1], x[2], x[3], x[4], x[5], canonical) - x[6]);
+			// A deviation which isn't a number is an error.
+			result[0] += !(error <= t);
+			if (!(error <= max_error))
+				max_error = error, result[1] = i;
+		}
+		memcpy(out, result, 16);
+		memcpy(out + 16, &max_error, 8);
+	} else if (r.flags == 0 && h->op == 4)
+		memcpy(out, text, len);
+	else if (r.flags == 0 && h->op == 6)
+		for (uint64_t i = 0; i < n; ++i, body += 48, out += 8 * N_COMPONENTS) {
+			double terms[N_COMPONENTS];
+			memcpy(x, body, 48);
+			ciede_2000_components(x[0], x[1], x[2], x[3], x[4], x[5], canonical, terms);
+			memcpy(out, terms, sizeof(terms));
+		}
+	free(text);
+	return r.flags != 0 || h->op != 5;
+}
+
+static void server_flush(server_worker *w, const int fd, size_t *out_len, size_t *n_pending) {
+	// Writes the responses, then measures the latencies of their requests.
+	const int ok = write_all(fd, w->out, *out_len);
+	const uint64_t now = get_time_ns();
+	pthread_mutex_lock(&w->lock);
+	for (size_t i = 0; ok && i < *n_pending; ++i)
+		sketch_add(w->latency + w->pending[i].op, (double) (now - w->pending[i].time_ns) / 1000.0);
+	pthread_mutex_unlock(&w->lock);
+	*out_len = 0, *n_pending = 0;
+	if (!ok)
+		shutdown(fd, SHUT_RDWR);
+}
+
+static int server_serve(server_worker *w, const int fd) {
+	// Answers the requests of a connection until it closes, and returns 0 when the server must stop.
+	size_t begin = 0, end = 0, out_len = 0, n_pending = 0;
+	int running = 1;
+	for (;;) {
+		server_header h;
+		// The complete requests already received are answered before reading more.
+		while (running && sizeof(h) <= end - begin) {
+			memcpy(&h, w->in + begin, sizeof(h));
+			if (SERVER_MAX_BODY < h.size) {
+				h.op = 0, h.size = 0;
+				server_answer(w, &h, 0, &out_len);
+				server_flush(w, fd, &out_len, &n_pending);
+				return 1;
+			}
+			if (end - begin < sizeof(h) + h.size)
+				break;
+			if (!reserve(&w->pending, &w->pending_size, (n_pending + 1) * sizeof(*w->pending)))
+				return 1;
+			w->pending[n_pending].op = SERVER_OPS <= h.op ? 0 : h.op;
+			w->pending[n_pending++].time_ns = get_time_ns();
+			running = server_answer(w, &h, w->in + begin + sizeof(h), &out_len);
+			begin += sizeof(h) + h.size;
+		}
+		if (out_len)
+			server_flush(w, fd, &out_len, &n_pending);
+		if (!running)
+			return 0;
+		memmove(w->in, w->in + begin, end - begin);
+		end -= begin, begin = 0;
+		if (sizeof(h) <= end)
+			memcpy(&h, w->in, sizeof(h));
+		if (!reserve(&w->in, &w->in_size, sizeof(h) <= end ? sizeof(h) + h.size : 65536))
+			return 1;
+		const ssize_t m = read(fd, w->in + end, w->in_size - end);
+		if (m < 0 && errno == EINTR)
+			continue;
+		if (m <= 0)
+			return 1;
+		end += (size_t) m;
+	}
+}
+
+static void *server_work(void *arg) {
+	server_worker *w = arg;
+	server *s = w->s;
+	for (;;) {
+		pthread_mutex_lock(&s->lock);
+		while (!s->stop && s->n_queued == 0)
+			pthread_cond_wait(&s->changed, &s->lock);
+		if (s->stop) {
+			pthread_mutex_unlock(&s->lock);
+			return 0;
+		}
+		w->fd = s->queue[s->head];
+		s->head = (s->head + 1) % SERVER_QUEUE, --s->n_queued;
+		pthread_cond_broadcast(&s->changed);
+		pthread_mutex_unlock(&s->lock);
+		const int running = server_serve(w, w->fd);
+		pthread_mutex_lock(&s->lock);
+		close(w->fd);
+		w->fd = -1;
+		pthread_mutex_unlock(&s->lock);
+		if (!running)
+			server_stop(s);
+	}
+}
+
+static void serve(state *state) {
+	const char *path = state->params.listen;
+	struct sockaddr_un address = {0};
+	struct sigaction action = {0};
+	struct stat info;
+	sigset_t signals, previous;
+	server s = {0};
+	int fd = -1, n_started = 0;
+	long n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+	s.state = state;
+	s.n_workers = 0 < state->params.threads ? state->params.threads : n_cores < 1 ? 1 : (int) n_cores;
+	if (sizeof(address.sun_path) <= strlen(path)) {
+		fprintf(stderr, "Delta E 2000: The socket path '%s' is too long.\n", path);
+		state->code = 2;
+		return;
+	}
+	// A socket left by a previous server is replaced, but not another kind of file.
+	if (stat(path, &info) == 0 && !S_ISSOCK(info.st_mode)) {
+		fprintf(stderr, "Delta E 2000: The file '%s' exists and isn't a socket.\n", path);
+		state->code = 3;
+		return;
+	}
+	unlink(path);
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, path);
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1 || bind(fd, (struct sockaddr *) &address, sizeof(address)) || listen(fd, 128)) {
+		perror("Delta E 2000");
+		state->code = 3;
+		if (fd != -1)
+			close(fd);
+		return;
+	}
+	// The clients leaving early don't stop the server, which stops on SIGINT, SIGTERM or a shutdown request.
+	signal(SIGPIPE, SIG_IGN);
+	action.sa_handler = server_on_signal;
+	sigaction(SIGINT, &action, 0);
+	sigaction(SIGTERM, &action, 0);
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &signals, &previous);
+	pthread_mutex_init(&s.lock, 0);
+	pthread_cond_init(&s.changed, 0);
+	s.workers = calloc((size_t) s.n_workers, sizeof(*s.workers));
+	if (s.workers)
+		for (; n_started < s.n_workers; ++n_started) {
+			server_worker *w = s.workers + n_started;
+			w->s = &s, w->fd = -1;
+			pthread_mutex_init(&w->lock, 0);
+			if (pthread_create(&w->thread, 0, server_work, w))
+				break;
+		}
+	pthread_sigmask(SIG_SETMASK, &previous, 0);
+	s.n_workers = n_started;
+	if (n_started == 0) {
+		perror("Delta E 2000");
+		state->code = 4;
+	} else if (state->params.verbose)
+		fprintf(stderr, "Listening on '%s' with %d workers.\n", path, n_started);
+	while (n_started && !server_signal) {
+		const int client = accept(fd, 0, 0);
+		pthread_mutex_lock(&s.lock);
+		if (s.stop || server_signal) {
+			pthread_mutex_unlock(&s.lock);
+			if (client != -1)
+				close(client);
+			break;
+		}
+		while (client != -1 && !s.stop && s.n_queued == SERVER_QUEUE)
+			pthread_cond_wait(&s.changed, &s.lock);
+		if (client != -1) {
+			s.queue[(s.head + s.n_queued++) % SERVER_QUEUE] = client;
+			pthread_cond_broadcast(&s.changed);
+		}
+		pthread_mutex_unlock(&s.lock);
+	}
+	if (n_started)
+		server_stop(&s);
+	for (int i = 0; i < n_started; ++i)
+		pthread_join(s.workers[i].thread, 0);
+	close(fd);
+	unlink(path);
+	for (; s.n_queued; --s.n_queued, s.head = (s.head + 1) % SERVER_QUEUE)
+		close(s.queue[s.head]);
+	if (state->params.verbose && n_started) {
+		char *text;
+		size_t len;
+		server_statistics(&s, &text, &len);
+		if (text)
+			fprintf(stderr, "%s", text);
+		free(text);
+	}
+	for (int i = 0; i < n_started; ++i) {
+		pthread_mutex_destroy(&s.workers[i].lock);
+		free(s.workers[i].in), free(s.workers[i].out), free(s.workers[i].pending);
+	}
+	free(s.workers);
+	pthread_cond_destroy(&s.changed);
+	pthread_mutex_destroy(&s.lock);
+}
+#else
+static void serve(state *state) {
+	fprintf(stderr, "Delta E 2000: The --listen option requires Unix sockets.\n");
+	state->code = 2;
+}
+#endif
+
 static void print_help(void) {
 	puts("           Name: Delta E 2000 Driver");
 	puts("    Description: Generate, solve and control Color Difference");
@@ -787,12 +1935,25 @@ static void print_help(void) {
 	puts("       -i <path> or --input-file to specify a file (default to stdin)");
 	puts("       -o <path> or --outout-file to specify a file (default to stdout)");
 	puts("       -c or --canonical to comply with the canonical definition of the hue mean");
+	puts("       -b or --both to solve in both definitions of the hue mean, or to accept either when controlling");
+	puts("       -a <tier> or --accuracy to trade accuracy for speed : balanced (1e-4, about 10% faster) or exact (default)");
+	puts("       -k <path> or --checkpoint to save the progress periodically, and resume from it");
+	puts("       -w <path> or --histogram to save the distributions of the Delta E and of the deviations");
+	puts("       -e or --self-test to check the Delta E 2000 of the built-in references, then exit");
+	puts("       -n or --no-self-test to skip this check, otherwise done before each job, for the short runs");
 	puts("");
 	puts("     Options:");
 	puts("       -g <count> or --generate to generate a dataset of Lab colors");
 	puts("          -r <seed> or --rand-seed to customize the RNG seed");
 	puts("       -s or --solve to solve a dataset by appending the Delta E 2000");
 	puts("          -p <digits> or --precision to customize the display precision");
+	puts("          -u or --group to parse once the first color shared by several rows");
+	puts("          -m or --components to append dL', dC', dH', S_L, S_C, S_H, R_T then the Delta E 2000");
+	puts("          -v or --verbose to report the duration and the quantiles of the Delta E");
+	puts("");
+	puts("       -l <path> or --listen to serve binary requests on a Unix socket (see the source code)");
+	puts("          -j <count> or --threads to customize the number of workers (default to all cores)");
+	puts("          -v or --verbose to report the latency quantiles when stopping");
 	puts("");
 	puts("     By default, without -g or -s this driver checks the lines it reads on its standard input");
 	puts("     and -t <number> (for --tolerance) can be used to adjust its tolerance (default to 1e-10)");
@@ -803,32 +1964,67 @@ static void print_help(void) {
 
 int main(int argc, const char *argv[]) {
 	state state = {0};
-	if (static_controls()) {
-		state.params.tolerance = 1e-10;
-		state.params.precision = 12;
-		for (int i = 1; i < argc; ++i)
-			if (!(i + 1 < argc && read_arg_2(argv + i, &state) && ++i))
-				if (!read_arg_1(argv + i, &state))
-					fprintf(stderr, "Delta E 2000: Unknown argument '%s'.\n", (state.code = 2, argv[i]));
-		if (state.params.help)
-			print_help();
-		else if (state.code == 0) {
-			open_descriptors(&state);
-			if (state.code == 0) {
-				if (state.params.generate)
-					generate(&state);
-				else if (state.params.mode == 's')
-					solve(&state);
-				else
-					control(&state);
-			}
-			close_descriptors(&state);
-		}
-	} else
+	state.params.tolerance = 1e-10;
+	state.params.precision = 12;
+	for (int i = 1; i < argc; ++i)
+		if (!(i + 1 < argc && read_arg_2(argv + i, &state) && ++i))
+			if (!read_arg_1(argv + i, &state))
+				fprintf(stderr, "Delta E 2000: Unknown argument '%s'.\n", (state.code = 2, argv[i]));
+	if (state.params.accuracy && strcmp(state.params.accuracy, "exact")) {
+		for (size_t i = 0; i < sizeof(tiers) / sizeof(*tiers); ++i)
+			if (!strcmp(state.params.accuracy, tiers[i].name))
+				state.tier = tiers + i;
+		if (state.tier == 0)
+			fprintf(stderr, "Delta E 2000: Unknown accuracy '%s'.\n", (state.code = 2, state.params.accuracy));
+	}
+	if (state.params.components && (state.params.both || state.tier)) {
+		// The terms are those of the exact ΔE2000, in one convention.
+		fprintf(stderr, "Delta E 2000: The --components option excludes --both and the accuracy tiers.\n");
+		state.code = 2;
+	}
+	if (state.params.checkpoint && state.code == 0 && !state.params.help) {
+		// Resuming requires to seek into the files, which is not possible with the standard streams.
+		if ((job_mode(&state) != 'g' && !state.params.input_file) || (job_mode(&state) != 'c' && !state.params.output_file)) {
+			fprintf(stderr, "Delta E 2000: The --checkpoint option requires an --input-file and an --output-file.\n");
+			state.code = 2;
+		} else
+			load_checkpoint(&state);
+	}
+	if (state.params.help)
+		print_help();
+	else if (state.params.self_test && state.code == 0) {
+		if (static_controls())
+			fprintf(stderr, "Delta E 2000: The %d references hold, in both orders and at each accuracy.\n", (int) (sizeof(references) / sizeof(*references)));
+		else
+			state.code = 1;
+	} else if (state.code == 0 && !state.params.no_self_test && !static_controls())
+		// The references are checked before each job, which scripts solving a line per call can skip.
 		state.code = 1;
+	else if (state.code == 0) {
+		open_descriptors(&state);
+		if (state.code == 0 && state.progress.resumed)
+			resume_checkpoint(&state);
+		if (state.code == 0) {
+			state.checkpoint_time = get_time_ms();
+			if (state.params.listen)
+				serve(&state);
+			else if (state.params.generate)
+				generate(&state);
+			else if (state.params.mode == 's')
+				solve(&state);
+			else
+				control(&state);
+			if (state.params.histogram && !state.params.generate)
+				save_histogram(&state);
+			// The job is complete, its next run will start from the beginning.
+			if (state.params.checkpoint)
+				remove(state.params.checkpoint);
+		}
+		close_descriptors(&state);
+	}
 	return state.code;
 }
 
 // Compilation is done with GCC or Clang :
-// - gcc -std=c99 -Wall -pedantic -O2 -g -o driver ciede-2000-driver.c -lm
-// - clang -std=c99 -Wall -pedantic -O2 -g -o driver ciede-2000-driver.c -lm
+// - gcc -std=c99 -Wall -pedantic -O2 -g -pthread -o driver ciede-2000-driver.c -lm
+// - clang -std=c99 -Wall -pedantic -O2 -g -pthread -o driver ciede-2000-driver.c -lm
@@ -0,0 +1,491 @@
+// This function written in C is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#include <math.h>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338328
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+static double ciede_2000(const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2) {
+	// Working in C with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const double k_l = 1.0;
+	const double k_c = 1.0;
+	const double k_h = 1.0;
+	double n = (sqrt(a_1 * a_1 + b_1 * b_1) + sqrt(a_2 * a_2 + b_2 * b_2)) * 0.5;
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = 1.0 + 0.5 * (1.0 - sqrt(n / (n + 6103515625.0)));
+	// Application of the chroma correction factor.
+	const double c_1 = sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const double c_2 = sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	double h_1 = atan2(b_1, a_1 * n);
+	double h_2 = atan2(b_2, a_2 * n);
+	h_1 += (h_1 < 0.0) * 2.0 * M_PI;
+	h_2 += (h_2 < 0.0) * 2.0 * M_PI;
+	n = fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (M_PI - 1E-14 < n && n < M_PI + 1E-14)
+		n = M_PI;
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	double h_m = (h_1 + h_2) * 0.5;
+	double h_d = (h_2 - h_1) * 0.5;
+	h_d += (M_PI < n) * M_PI;
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (M_PI < n) * M_PI;
+	// h_m += (M_PI < n) * ((h_m < M_PI) - (M_PI <= h_m)) * M_PI;
+	const double p = 36.0 * h_m - 55.0 * M_PI;
+	n = (c_1 + c_2) * 0.5;
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const double r_t = -2.0 * sqrt(n / (n + 6103515625.0))
+			* sin(M_PI / 3.0 * exp(p * p / (-25.0 * M_PI * M_PI)));
+	n = (l_1 + l_2) * 0.5;
+	n = (n - 50.0) * (n - 50.0);
+	// Lightness.
+	const double l = (l_2 - l_1) / (k_l * (1.0 + 0.015 * n / sqrt(20.0 + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const double t = 1.0	+ 0.24 * sin(2.0 * h_m + M_PI / 2.0)
+				+ 0.32 * sin(3.0 * h_m + 8.0 * M_PI / 15.0)
+				- 0.17 * sin(h_m + M_PI / 3.0)
+				- 0.20 * sin(4.0 * h_m + 3.0 * M_PI / 20.0);
+	n = c_1 + c_2;
+	// Hue.
+	const double h = 2.0 * sqrt(c_1 * c_2) * sin(h_d) / (k_h * (1.0 + 0.0075 * n * t));
+	// Chroma.
+	const double c = (c_2 - c_1) / (k_c * (1.0 + 0.0225 * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 42.0   a1 = 20.2   b1 = -4.8
+// L2 = 40.0   a2 = 14.3   b2 = 3.5
+// CIE ΔE00 = 7.0461082693 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 7.0460891713 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.9e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////     Target Delta E Pairs        ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// This C program generates pairs of L*a*b* colors whose Delta E 2000 is a chosen target, using all the CPU cores.
+// The sample is the standard color plus a perturbation drawn from the statistics of 100 billion random pairs,
+// available in "tests/datasets/stats/delta-e-2000-lab-stats-100B-pairs.txt" and embedded below :
+// - |ΔL|, |Δa| and |Δb| follow the normal distributions given by the table (interpolated for the target).
+// - Each component of the perturbation then receives a random sign.
+// The perturbation is scaled by a factor "t", refined with secant steps on ciede_2000 until the ΔE2000 of the
+// pair lies within the tolerance of the target, a candidate that does not converge (or leaves 0 <= L <= 100) is
+// drawn again. The output is the same as ciede-2000-random.c : L1,a1,b1,L2,a2,b2,ΔE (or 7 doubles in binary).
+
+// Each block of pairs has its own seed, derived from the main seed, so the output only depends on the seed.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#define BLOCK_PAIRS 16384
+#define MAX_THREADS 256
+#define MAX_SECANT_STEPS 12
+#define MAX_ATTEMPTS 100000
+
+// Columns : mean and standard deviation of |ΔL|, |Δa| and |Δb|, for a ΔE2000 of 0.1, 0.2, ... 19.9.
+static const double lab_stats[199][6] = {
+	{0.05372, 0.03612, 0.1821, 0.1322, 0.1856, 0.1494}, {0.1116, 0.07103, 0.3908, 0.2723, 0.4061, 0.3045}, {0.1793, 0.1112, 0.6191, 0.4204, 0.6499, 0.4738},
+	{0.2491, 0.1516, 0.846, 0.5726, 0.8915, 0.6518}, {0.318, 0.1938, 1.088, 0.7327, 1.139, 0.8231}, {0.388, 0.2356, 1.318, 0.8878, 1.386, 1.002},
+	{0.4578, 0.2765, 1.554, 1.038, 1.634, 1.177}, {0.5267, 0.3191, 1.789, 1.197, 1.878, 1.349}, {0.5974, 0.3609, 2.022, 1.351, 2.115, 1.518},
+	{0.6684, 0.4026, 2.25, 1.506, 2.361, 1.686}, {0.737, 0.4449, 2.485, 1.662, 2.606, 1.863}, {0.8085, 0.4867, 2.714, 1.814, 2.843, 2.031},
+	{0.877, 0.5288, 2.944, 1.966, 3.083, 2.202}, {0.9481, 0.5702, 3.173, 2.12, 3.323, 2.368}, {1.017, 0.6127, 3.401, 2.271, 3.561, 2.536},
+	{1.087, 0.6546, 3.625, 2.422, 3.798, 2.7}, {1.158, 0.6966, 3.854, 2.573, 4.029, 2.865}, {1.228, 0.7383, 4.076, 2.722, 4.263, 3.03},
+	{1.298, 0.7799, 4.299, 2.869, 4.498, 3.193}, {1.366, 0.8211, 4.531, 3.022, 4.735, 3.353}, {1.438, 0.8632, 4.747, 3.172, 4.961, 3.509},
+	{1.508, 0.9037, 4.963, 3.313, 5.189, 3.67}, {1.578, 0.9465, 5.185, 3.461, 5.419, 3.831}, {1.648, 0.9878, 5.398, 3.604, 5.648, 3.987},
+	{1.719, 1.031, 5.618, 3.751, 5.864, 4.139}, {1.787, 1.071, 5.839, 3.897, 6.099, 4.297}, {1.859, 1.113, 6.053, 4.042, 6.322, 4.455},
+	{1.927, 1.154, 6.272, 4.182, 6.551, 4.611}, {1.997, 1.196, 6.487, 4.329, 6.771, 4.761}, {2.069, 1.237, 6.702, 4.471, 6.994, 4.913},
+	{2.137, 1.279, 6.912, 4.608, 7.217, 5.062}, {2.208, 1.321, 7.121, 4.749, 7.436, 5.215}, {2.279, 1.362, 7.336, 4.892, 7.646, 5.363},
+	{2.347, 1.403, 7.545, 5.033, 7.872, 5.511}, {2.417, 1.444, 7.753, 5.173, 8.086, 5.659}, {2.487, 1.485, 7.964, 5.31, 8.304, 5.805},
+	{2.557, 1.527, 8.167, 5.447, 8.512, 5.948}, {2.627, 1.568, 8.376, 5.587, 8.729, 6.093}, {2.697, 1.609, 8.585, 5.724, 8.943, 6.237},
+	{2.766, 1.65, 8.788, 5.86, 9.158, 6.381}, {2.838, 1.692, 8.99, 5.995, 9.369, 6.524}, {2.906, 1.732, 9.197, 6.132, 9.585, 6.671},
+	{2.976, 1.774, 9.397, 6.266, 9.783, 6.803}, {3.045, 1.814, 9.599, 6.398, 10, 6.946}, {3.117, 1.856, 9.801, 6.534, 10.21, 7.092},
+	{3.185, 1.897, 10.01, 6.666, 10.41, 7.227}, {3.255, 1.937, 10.2, 6.802, 10.62, 7.364}, {3.324, 1.978, 10.4, 6.933, 10.83, 7.504},
+	{3.394, 2.018, 10.6, 7.061, 11.04, 7.642}, {3.466, 2.06, 10.79, 7.193, 11.23, 7.772}, {3.533, 2.101, 10.99, 7.325, 11.43, 7.903},
+	{3.603, 2.141, 11.19, 7.454, 11.64, 8.042}, {3.673, 2.182, 11.38, 7.582, 11.85, 8.181}, {3.742, 2.223, 11.58, 7.714, 12.05, 8.311},
+	{3.812, 2.264, 11.77, 7.842, 12.25, 8.448}, {3.88, 2.304, 11.97, 7.972, 12.45, 8.575}, {3.952, 2.345, 12.15, 8.095, 12.65, 8.711},
+	{4.02, 2.385, 12.35, 8.226, 12.84, 8.837}, {4.09, 2.426, 12.54, 8.353, 13.04, 8.966}, {4.159, 2.466, 12.73, 8.476, 13.24, 9.098},
+	{4.228, 2.507, 12.92, 8.602, 13.44, 9.226}, {4.298, 2.547, 13.11, 8.727, 13.63, 9.348}, {4.366, 2.587, 13.3, 8.85, 13.83, 9.483},
+	{4.437, 2.628, 13.48, 8.973, 14.02, 9.601}, {4.506, 2.669, 13.67, 9.101, 14.21, 9.735}, {4.577, 2.709, 13.85, 9.22, 14.4, 9.856},
+	{4.647, 2.748, 14.04, 9.345, 14.6, 9.98}, {4.714, 2.789, 14.22, 9.47, 14.79, 10.11}, {4.783, 2.829, 14.41, 9.585, 14.98, 10.23},
+	{4.853, 2.869, 14.6, 9.709, 15.16, 10.35}, {4.921, 2.909, 14.78, 9.829, 15.35, 10.47}, {4.993, 2.95, 14.95, 9.951, 15.54, 10.59},
+	{5.06, 2.99, 15.14, 10.07, 15.73, 10.72}, {5.128, 3.03, 15.32, 10.19, 15.92, 10.84}, {5.197, 3.07, 15.5, 10.31, 16.11, 10.96},
+	{5.267, 3.11, 15.68, 10.42, 16.29, 11.08}, {5.335, 3.149, 15.86, 10.55, 16.48, 11.2}, {5.405, 3.19, 16.03, 10.66, 16.66, 11.31},
+	{5.474, 3.23, 16.21, 10.78, 16.84, 11.43}, {5.543, 3.269, 16.39, 10.89, 17.02, 11.55}, {5.613, 3.309, 16.56, 11.01, 17.2, 11.67},
+	{5.682, 3.349, 16.74, 11.13, 17.39, 11.78}, {5.75, 3.389, 16.91, 11.24, 17.57, 11.9}, {5.818, 3.429, 17.09, 11.36, 17.76, 12.02},
+	{5.886, 3.468, 17.26, 11.47, 17.93, 12.13}, {5.956, 3.508, 17.44, 11.59, 18.11, 12.24}, {6.024, 3.547, 17.6, 11.7, 18.3, 12.36},
+	{6.093, 3.587, 17.78, 11.81, 18.47, 12.47}, {6.161, 3.626, 17.96, 11.93, 18.65, 12.58}, {6.23, 3.666, 18.12, 12.04, 18.83, 12.7},
+	{6.299, 3.705, 18.29, 12.15, 19.01, 12.81}, {6.369, 3.745, 18.46, 12.26, 19.18, 12.92}, {6.436, 3.785, 18.63, 12.37, 19.36, 13.03},
+	{6.504, 3.824, 18.8, 12.49, 19.53, 13.14}, {6.574, 3.863, 18.97, 12.59, 19.7, 13.25}, {6.641, 3.902, 19.13, 12.7, 19.88, 13.36},
+	{6.71, 3.942, 19.3, 12.81, 20.05, 13.47}, {6.777, 3.98, 19.47, 12.92, 20.23, 13.58}, {6.845, 4.02, 19.63, 13.03, 20.4, 13.69},
+	{6.917, 4.06, 19.79, 13.14, 20.57, 13.79}, {6.984, 4.099, 19.96, 13.25, 20.74, 13.9}, {7.051, 4.138, 20.12, 13.36, 20.91, 14.01},
+	{7.12, 4.177, 20.29, 13.46, 21.08, 14.11}, {7.188, 4.216, 20.45, 13.57, 21.26, 14.22}, {7.255, 4.254, 20.61, 13.68, 21.43, 14.33},
+	{7.326, 4.294, 20.77, 13.78, 21.59, 14.43}, {7.392, 4.333, 20.94, 13.89, 21.77, 14.54}, {7.46, 4.372, 21.09, 14, 21.93, 14.64},
+	{7.526, 4.411, 21.26, 14.1, 22.1, 14.75}, {7.597, 4.449, 21.42, 14.2, 22.27, 14.85}, {7.665, 4.489, 21.58, 14.31, 22.43, 14.95},
+	{7.731, 4.528, 21.73, 14.41, 22.6, 15.05}, {7.799, 4.567, 21.89, 14.52, 22.77, 15.16}, {7.868, 4.606, 22.05, 14.62, 22.93, 15.26},
+	{7.934, 4.644, 22.21, 14.73, 23.09, 15.36}, {8.003, 4.683, 22.36, 14.83, 23.26, 15.47}, {8.07, 4.721, 22.51, 14.93, 23.42, 15.57},
+	{8.137, 4.759, 22.67, 15.03, 23.59, 15.66}, {8.204, 4.799, 22.83, 15.14, 23.75, 15.77}, {8.273, 4.837, 22.98, 15.23, 23.91, 15.87},
+	{8.34, 4.876, 23.14, 15.34, 24.07, 15.96}, {8.409, 4.914, 23.29, 15.44, 24.24, 16.06}, {8.474, 4.952, 23.45, 15.54, 24.4, 16.16},
+	{8.544, 4.992, 23.59, 15.64, 24.55, 16.26}, {8.611, 5.029, 23.75, 15.74, 24.72, 16.36}, {8.679, 5.068, 23.9, 15.84, 24.88, 16.46},
+	{8.745, 5.107, 24.05, 15.94, 25.04, 16.55}, {8.813, 5.145, 24.2, 16.04, 25.2, 16.65}, {8.879, 5.183, 24.35, 16.14, 25.36, 16.75},
+	{8.947, 5.222, 24.5, 16.24, 25.51, 16.84}, {9.015, 5.259, 24.65, 16.33, 25.67, 16.94}, {9.081, 5.298, 24.8, 16.44, 25.83, 17.04},
+	{9.147, 5.336, 24.95, 16.53, 25.99, 17.13}, {9.214, 5.374, 25.1, 16.63, 26.14, 17.23}, {9.281, 5.412, 25.25, 16.73, 26.3, 17.32},
+	{9.347, 5.45, 25.4, 16.82, 26.46, 17.41}, {9.416, 5.488, 25.54, 16.92, 26.61, 17.5}, {9.483, 5.526, 25.69, 17.02, 26.77, 17.6},
+	{9.549, 5.565, 25.83, 17.12, 26.93, 17.7}, {9.616, 5.603, 25.98, 17.21, 27.07, 17.79}, {9.681, 5.64, 26.13, 17.31, 27.23, 17.88},
+	{9.748, 5.678, 26.27, 17.41, 27.38, 17.98}, {9.815, 5.717, 26.42, 17.51, 27.54, 18.07}, {9.884, 5.754, 26.56, 17.6, 27.68, 18.15},
+	{9.948, 5.791, 26.71, 17.7, 27.84, 18.25}, {10.01, 5.83, 26.85, 17.79, 27.99, 18.34}, {10.08, 5.868, 27, 17.89, 28.14, 18.43},
+	{10.15, 5.905, 27.14, 17.99, 28.3, 18.52}, {10.21, 5.943, 27.28, 18.08, 28.45, 18.61}, {10.28, 5.98, 27.43, 18.18, 28.6, 18.71},
+	{10.35, 6.018, 27.57, 18.27, 28.75, 18.79}, {10.41, 6.056, 27.71, 18.37, 28.9, 18.88}, {10.48, 6.093, 27.85, 18.47, 29.05, 18.97},
+	{10.54, 6.13, 27.99, 18.57, 29.2, 19.06}, {10.61, 6.169, 28.13, 18.66, 29.34, 19.15}, {10.68, 6.206, 28.27, 18.76, 29.5, 19.24},
+	{10.74, 6.243, 28.41, 18.86, 29.64, 19.32}, {10.81, 6.28, 28.55, 18.95, 29.79, 19.41}, {10.87, 6.318, 28.69, 19.05, 29.93, 19.5},
+	{10.94, 6.356, 28.83, 19.14, 30.09, 19.59}, {11, 6.393, 28.97, 19.24, 30.24, 19.67}, {11.07, 6.43, 29.11, 19.34, 30.38, 19.76},
+	{11.14, 6.467, 29.25, 19.44, 30.53, 19.85}, {11.2, 6.504, 29.39, 19.53, 30.67, 19.93}, {11.27, 6.541, 29.52, 19.61, 30.81, 20.01},
+	{11.33, 6.58, 29.65, 19.71, 30.96, 20.1}, {11.4, 6.616, 29.79, 19.8, 31.1, 20.18}, {11.46, 6.653, 29.93, 19.89, 31.25, 20.27},
+	{11.53, 6.69, 30.06, 19.98, 31.39, 20.35}, {11.59, 6.727, 30.19, 20.07, 31.54, 20.44}, {11.66, 6.765, 30.32, 20.15, 31.68, 20.52},
+	{11.73, 6.801, 30.46, 20.24, 31.82, 20.6}, {11.79, 6.838, 30.59, 20.33, 31.96, 20.68}, {11.86, 6.874, 30.72, 20.41, 32.1, 20.76},
+	{11.92, 6.912, 30.84, 20.5, 32.24, 20.84}, {11.99, 6.948, 30.98, 20.59, 32.38, 20.92}, {12.05, 6.987, 31.1, 20.67, 32.52, 21.01},
+	{12.12, 7.023, 31.23, 20.75, 32.66, 21.08}, {12.18, 7.058, 31.36, 20.84, 32.8, 21.16}, {12.25, 7.096, 31.49, 20.92, 32.94, 21.25},
+	{12.31, 7.132, 31.62, 21, 33.08, 21.32}, {12.38, 7.169, 31.75, 21.09, 33.22, 21.4}, {12.44, 7.207, 31.87, 21.17, 33.37, 21.48},
+	{12.51, 7.242, 32, 21.25, 33.5, 21.56}, {12.57, 7.28, 32.12, 21.34, 33.64, 21.64}, {12.64, 7.316, 32.25, 21.42, 33.77, 21.72},
+	{12.7, 7.352, 32.37, 21.5, 33.91, 21.8}, {12.77, 7.389, 32.5, 21.58, 34.05, 21.87}, {12.83, 7.425, 32.63, 21.66, 34.18, 21.95},
+	{12.9, 7.463, 32.75, 21.74, 34.32, 22.03}, {12.96, 7.499, 32.87, 21.82, 34.46, 22.11}, {13.02, 7.534, 33, 21.9, 34.6, 22.19},
+	{13.09, 7.572, 33.12, 21.98, 34.74, 22.27}, {13.15, 7.607, 33.24, 22.06, 34.87, 22.34}, {13.22, 7.644, 33.36, 22.14, 35.01, 22.42},
+	{13.28, 7.681, 33.48, 22.22, 35.14, 22.5}, {13.35, 7.718, 33.6, 22.29, 35.27, 22.57}, {13.41, 7.754, 33.72, 22.37, 35.41, 22.65},
+	{13.47, 7.789, 33.84, 22.45, 35.55, 22.73},
+};
+
+typedef struct {
+	struct {
+		const char *format;
+		const char *output_file;
+		double delta_e;
+		double tolerance;
+		uint64_t count;
+		uint64_t seed;
+		int precision;
+		int threads;
+		int verbose;
+		int help;
+	} params;
+	FILE *out_fp;
+	int code;
+} state;
+
+typedef struct {
+	char *data;
+	size_t len;
+	size_t cap;
+} out_buffer;
+
+typedef struct {
+	const state *state;
+	double stats[6];
+	int binary;
+	uint64_t block;
+	int n_pairs;
+	double *pairs;
+	out_buffer out;
+	uint64_t n_attempts;
+	uint64_t n_steps;
+	int failed;
+} worker;
+
+static inline uint64_t xor_random(uint64_t *s) {
+	// A shift-register generator has a reproducible behavior across platforms.
+	return *s ^= *s << 13, *s ^= *s >> 7, *s ^= *s << 17;
+}
+
+static inline uint64_t split_mix(uint64_t x) {
+	// Derives well-distributed (and never zero in practice) seeds from consecutive block numbers.
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return (x ^ (x >> 31)) | 1;
+}
+
+static inline double rand_unit(uint64_t *s) {
+	// Returns a number in [0, 1) having 53 random bits.
+	return (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static inline double rand_normal(uint64_t *s) {
+	// Box-Muller transform, the first uniform number is kept away from zero.
+	const double u = 1.0 - rand_unit(s), v = rand_unit(s);
+	return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static void interpolate_stats(const double delta_e, double *stats) {
+	// Linear interpolation between the rows, and proportional scaling outside of the table.
+	const double x = delta_e * 10.0 - 1.0;
+	int i = (int) floor(x);
+	double f = x - i, scale = 1.0;
+	if (i < 0)
+		i = 0, f = 0.0, scale = delta_e / 0.1;
+	else if (198 <= i)
+		i = 197, f = 1.0, scale = delta_e / 19.9;
+	for (int j = 0; j < 6; ++j)
+		stats[j] = scale * (lab_stats[i][j] + f * (lab_stats[i + 1][j] - lab_stats[i][j]));
+}
+
+static inline double delta_e_along(const double *restrict standard, const double *restrict direction, const double t) {
+	return ciede_2000(standard[0], standard[1], standard[2], standard[0] + t * direction[0], standard[1] + t * direction[1], standard[2] + t * direction[2]);
+}
+
+static int try_pair(worker *w, uint64_t *seed, double *restrict pair) {
+	const double target = w->state->params.delta_e, tolerance = w->state->params.tolerance;
+	double direction[3];
+	pair[0] = 100.0 * rand_unit(seed);
+	pair[1] = 256.0 * rand_unit(seed) - 128.0;
+	pair[2] = 256.0 * rand_unit(seed) - 128.0;
+	for (int i = 0; i < 3; ++i) {
+		direction[i] = fabs(w->stats[2 * i] + w->stats[2 * i + 1] * rand_normal(seed));
+		if (xor_random(seed) >> 63)
+			direction[i] = -direction[i];
+	}
+	// Secant method on f(t) = ΔE2000(standard, standard + t * direction) - target, knowing that f(0) = -target,
+	// the first step is a proportional scaling of the perturbation drawn from the statistics.
+	double t_0 = 0.0, f_0 = -target, t_1 = 1.0, f_1 = delta_e_along(pair, direction, t_1) - target;
+	for (int i = 0; i < MAX_SECANT_STEPS && tolerance < fabs(f_1); ++i) {
+		if (f_1 == f_0)
+			return 0;
+		const double t_2 = t_1 - f_1 * (t_1 - t_0) / (f_1 - f_0);
+		if (!(0.0 < t_2 && t_2 < 1E6))
+			return 0;
+		t_0 = t_1, f_0 = f_1, t_1 = t_2;
+		f_1 = delta_e_along(pair, direction, t_1) - target;
+		++w->n_steps;
+	}
+	pair[3] = pair[0] + t_1 * direction[0];
+	pair[4] = pair[1] + t_1 * direction[1];
+	pair[5] = pair[2] + t_1 * direction[2];
+	pair[6] = ciede_2000(pair[0], pair[1], pair[2], pair[3], pair[4], pair[5]);
+	return fabs(pair[6] - target) <= tolerance && 0.0 <= pair[3] && pair[3] <= 100.0;
+}
+
+static void out_reserve(out_buffer *out, const size_t len) {
+	if (out->cap < out->len + len) {
+		out->cap = (out->len + len) << 1;
+		out->data = realloc(out->data, out->cap);
+		if (out->data == 0) {
+			perror("Delta E 2000");
+			exit(4);
+		}
+	}
+}
+
+static void *generate_block(void *arg) {
+	worker *w = arg;
+	uint64_t seed = split_mix(w->state->params.seed ^ split_mix(w->block));
+	const int p = w->state->params.precision;
+	w->out.len = 0;
+	for (int i = 0; i < w->n_pairs && !w->failed; ++i) {
+		double *pair = w->pairs + 7 * i;
+		int accepted = 0, attempts = 0;
+		while (!accepted && attempts < MAX_ATTEMPTS)
+			accepted = try_pair(w, &seed, pair), ++attempts;
+		w->n_attempts += (uint64_t) attempts;
+		if (!accepted)
+			w->failed = 1;
+		else if (!w->binary) {
+			out_reserve(&w->out, 7 * 32);
+			for (int j = 0; j < 7; ++j)
+				w->out.len += (size_t) sprintf(w->out.data + w->out.len, "%.*g%c", p, pair[j], j == 6 ? '\n' : ',');
+		}
+	}
+	return 0;
+}
+
+static uint64_t get_time_ms(void) {
+	// returns the current Unix timestamp with milliseconds.
+	struct timeval time;
+	gettimeofday(&time, 0);
+	return (uint64_t) time.tv_sec * 1000 + (uint64_t) time.tv_usec / 1000;
+}
+
+static void generate(state *state) {
+	const uint64_t time_1 = get_time_ms();
+	const int n_threads = state->params.threads;
+	const int binary = state->params.format && !strcmp(state->params.format, "binary");
+	worker *workers = calloc((size_t) n_threads, sizeof(*workers));
+	pthread_t threads[MAX_THREADS];
+	uint64_t n_done = 0, n_attempts = 0, n_steps = 0;
+	if (workers == 0) {
+		perror("Delta E 2000");
+		exit(4);
+	}
+	for (int i = 0; i < n_threads; ++i) {
+		workers[i].state = state, workers[i].binary = binary;
+		interpolate_stats(state->params.delta_e, workers[i].stats);
+		workers[i].pairs = malloc(7 * BLOCK_PAIRS * sizeof(double));
+		if (workers[i].pairs == 0) {
+			perror("Delta E 2000");
+			exit(4);
+		}
+	}
+	for (uint64_t block = 0; n_done < state->params.count && state->code == 0;) {
+		// Each round gives a block to every worker, then the main thread writes the blocks in order.
+		int n = 0;
+		for (uint64_t remaining = state->params.count - n_done; n < n_threads && remaining; ++n, ++block) {
+			workers[n].block = block;
+			workers[n].n_pairs = (int) (remaining < BLOCK_PAIRS ? remaining : BLOCK_PAIRS);
+			remaining -= (uint64_t) workers[n].n_pairs;
+		}
+		for (int i = 1; i < n; ++i)
+			if (pthread_create(threads + i, 0, generate_block, workers + i)) {
+				perror("Delta E 2000");
+				exit(4);
+			}
+		generate_block(workers);
+		for (int i = 1; i < n; ++i)
+			pthread_join(threads[i], 0);
+		for (int i = 0; i < n && state->code == 0; ++i)
+			if (workers[i].failed) {
+				fprintf(stderr, "Delta E 2000: The target %g can't be reached within %g.\n", state->params.delta_e, state->params.tolerance);
+				state->code = 5;
+			} else {
+				if (binary)
+					fwrite(workers[i].pairs, 7 * sizeof(double), (size_t) workers[i].n_pairs, state->out_fp);
+				else
+					fwrite(workers[i].out.data, 1, workers[i].out.len, state->out_fp);
+				n_done += (uint64_t) workers[i].n_pairs;
+			}
+	}
+	for (int i = 0; i < n_threads; ++i) {
+		n_attempts += workers[i].n_attempts, n_steps += workers[i].n_steps;
+		free(workers[i].pairs), free(workers[i].out.data);
+	}
+	free(workers);
+	if (state->params.verbose) {
+		const double seconds = (double) (get_time_ms() - time_1) / 1000.0;
+		fprintf(stderr, "Generated %" PRIu64 " pairs at ΔE2000 = %g ± %g using %d threads in %.2f s (%.0f pairs per second).\n", n_done, state->params.delta_e, state->params.tolerance, n_threads, seconds, n_done / (seconds < 0.001 ? 0.001 : seconds));
+		fprintf(stderr, "Acceptance rate : %.2f %%, secant steps per candidate : %.2f, seed : %" PRIu64 ".\n", n_attempts ? 100.0 * n_done / n_attempts : 0.0, n_attempts ? (double) n_steps / n_attempts : 0.0, state->params.seed);
+	}
+}
+
+#define DeltaE(a, b, c) if (!strcmp(key, "--" #a) || !strcmp(key, "-" #b)) (c)
+static int read_arg_2(const char **argv, state *state) {
+	// Reads a key/value parameter received on the command line.
+	const char *key = *argv, *value = *(argv + 1);
+	DeltaE(delta-e, e, state->params.delta_e = strtod(value, 0));
+	else DeltaE(count, n, state->params.count = strtoull(value, 0, 10));
+	else DeltaE(tolerance, t, state->params.tolerance = strtod(value, 0));
+	else DeltaE(format, f, state->params.format = value);
+	else DeltaE(output-file, o, state->params.output_file = value);
+	else DeltaE(precision, p, state->params.precision = (int) strtol(value, 0, 10));
+	else DeltaE(seed, s, state->params.seed = strtoull(value, 0, 10));
+	else DeltaE(threads, j, state->params.threads = (int) strtol(value, 0, 10));
+	else
+		return 0;
+	return 1;
+}
+
+static int read_arg_1(const char **argv, state *state) {
+	// Reads a flag received on the command line.
+	const char *key = *argv;
+	DeltaE(help, h, state->params.help = 1);
+	else DeltaE(verbose, v, state->params.verbose = 1);
+	else
+		return 0;
+	return 1;
+}
+#undef DeltaE
+
+static void print_help(void) {
+	puts("           Name: Delta E 2000 Target Pairs Generator");
+	puts("    Description: Generate L*a*b* color pairs having a given Color Difference");
+	puts("");
+	puts("     Options:");
+	puts("       -e <value> or --delta-e to specify the target ΔE2000 (required, up to 100)");
+	puts("       -n <count> or --count to customize the number of pairs (default to 10000)");
+	puts("       -t <value> or --tolerance to customize the accepted deviation (default to 1e-9)");
+	puts("       -f <format> or --format to choose between csv and binary (7 doubles per pair)");
+	puts("       -o <path> or --output-file to specify a file (default to stdout)");
+	puts("       -p <digits> or --precision to customize the CSV significant digits (default to 17)");
+	puts("       -s <number> or --seed to reproduce a previous output (default to the time)");
+	puts("       -j <count> or --threads to customize the number of threads (default to all cores)");
+	puts("       -v or --verbose to display statistics on stderr");
+	puts("");
+	puts(" GitHub Project: https://github.com/michel-leonard/ciede2000-color-matching");
+}
+
+int main(int argc, const char *argv[]) {
+	state state = {0};
+	state.params.count = 10000;
+	state.params.tolerance = 1E-9;
+	state.params.precision = 17;
+	state.params.seed = 0xc6a4a7935bd1e995ULL ^ get_time_ms();
+	for (int i = 1; i < argc; ++i)
+		if (!(i + 1 < argc && read_arg_2(argv + i, &state) && ++i))
+			if (!read_arg_1(argv + i, &state))
+				fprintf(stderr, "Delta E 2000: Unknown argument '%s'.\n", (state.code = 2, argv[i]));
+	if (state.params.threads < 1) {
+		const long n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+		state.params.threads = n_cores < 1 ? 1 : (int) n_cores;
+	}
+	if (MAX_THREADS < state.params.threads)
+		state.params.threads = MAX_THREADS;
+	if (state.params.precision < 1 || 17 < state.params.precision)
+		state.params.precision = 17;
+	// Below 1e-13 the rounding errors of the ΔE2000 itself would prevent the convergence.
+	if (!(1E-13 <= state.params.tolerance))
+		state.params.tolerance = 1E-13;
+	if (state.params.help)
+		print_help();
+	else if (state.code == 0 && !(0.0 < state.params.delta_e && state.params.delta_e <= 100.0)) {
+		fprintf(stderr, "Delta E 2000: The target ΔE2000 must be specified with -e, between 0 and 100.\n");
+		state.code = 2;
+	} else if (state.code == 0) {
+		state.out_fp = stdout;
+		if (state.params.output_file && (state.out_fp = fopen(state.params.output_file, "wb")) == 0) {
+			perror("Delta E 2000");
+			state.code = 3;
+		} else {
+			generate(&state);
+			if (state.out_fp != stdout)
+				fclose(state.out_fp);
+		}
+	}
+	return state.code;
+}
+
+// This file is named "ciede-2000-target-pairs.c"
+
+// The compilation is done using GCC or CLang :
+// - gcc -std=c99 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-target-pairs ciede-2000-target-pairs.c -lm
+// - clang -std=c99 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-target-pairs ciede-2000-target-pairs.c -lm
+
+// Finally, the execution is done using ./ciede-2000-target-pairs -e 2.5 -n 1000000 -o pairs-at-2.5.csv
@@ -0,0 +1,209 @@
+// This C program is released into the public domain.
+// Provided "as is", without any warranty, express or implied.
+
+#include "libciede2000.h"
+
+/////////////////////////////////////////////////
+////////                                 ////////
+////////             CIEDE2000           ////////
+////////      Shared Library Testing     ////////
+////////                                 ////////
+/////////////////////////////////////////////////
+
+// This program checks each entry point of libciede2000 (scalar, batch, one-to-many and matrix, in 64-bit and
+// 32-bit) against the reference ciede_2000 function, on random colors, then displays the throughputs of the
+// active code path. Running it with CIEDE2000_PATH=sse2 (or avx2, avx512) in the environment tests the other
+// code paths supported by the processor, and CIEDE2000_TUNE=file the configuration chosen by the tuner.
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338328
+#endif
+
+// The reference, as found in ciede-2000.c.
+static double ciede_2000(const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2) {
+	const double k_l = 1.0;
+	const double k_c = 1.0;
+	const double k_h = 1.0;
+	double n = (sqrt(a_1 * a_1 + b_1 * b_1) + sqrt(a_2 * a_2 + b_2 * b_2)) * 0.5;
+	n = n * n * n * n * n * n * n;
+	n = 1.0 + 0.5 * (1.0 - sqrt(n / (n + 6103515625.0)));
+	const double c_1 = sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const double c_2 = sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	double h_1 = atan2(b_1, a_1 * n);
+	double h_2 = atan2(b_2, a_2 * n);
+	h_1 += (h_1 < 0.0) * 2.0 * M_PI;
+	h_2 += (h_2 < 0.0) * 2.0 * M_PI;
+	n = fabs(h_2 - h_1);
+	if (M_PI - 1E-14 < n && n < M_PI + 1E-14)
+		n = M_PI;
+	double h_m = (h_1 + h_2) * 0.5;
+	double h_d = (h_2 - h_1) * 0.5;
+	h_d += (M_PI < n) * M_PI;
+	h_m += (M_PI < n) * M_PI;
+	const double p = 36.0 * h_m - 55.0 * M_PI;
+	n = (c_1 + c_2) * 0.5;
+	n = n * n * n * n * n * n * n;
+	const double r_t = -2.0 * sqrt(n / (n + 6103515625.0))
+			* sin(M_PI / 3.0 * exp(p * p / (-25.0 * M_PI * M_PI)));
+	n = (l_1 + l_2) * 0.5;
+	n = (n - 50.0) * (n - 50.0);
+	const double l = (l_2 - l_1) / (k_l * (1.0 + 0.015 * n / sqrt(20.0 + n)));
+	const double t = 1.0	+ 0.24 * sin(2.0 * h_m + M_PI / 2.0)
+				+ 0.32 * sin(3.0 * h_m + 8.0 * M_PI / 15.0)
+				- 0.17 * sin(h_m + M_PI / 3.0)
+				- 0.20 * sin(4.0 * h_m + 3.0 * M_PI / 20.0);
+	n = c_1 + c_2;
+	const double h = 2.0 * sqrt(c_1 * c_2) * sin(h_d) / (k_h * (1.0 + 0.0075 * n * t));
+	const double c = (c_2 - c_1) / (k_c * (1.0 + 0.0225 * n));
+	return sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+static uint64_t xor_random(uint64_t *s) {
+	return *s ^= *s << 13, *s ^= *s >> 7, *s ^= *s << 17;
+}
+
+static double uniform(uint64_t *s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double now(void) {
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return (double) t.tv_sec + (double) t.tv_nsec * 1E-9;
+}
+
+#define N_COLORS 1000
+
+int main(int argc, char *argv[]) {
+	// Usage : ./libciede2000-test [number of pairs]
+	const long parsed = 1 < argc ? strtol(argv[1], 0, 10) : 0;
+	const size_t n = parsed < N_COLORS * N_COLORS ? N_COLORS * N_COLORS : (size_t) parsed;
+	double *in = malloc(6 * n * sizeof(double)), *out = malloc(n * sizeof(double)), *expected = malloc(n * sizeof(double));
+	float *in_f = malloc(6 * n * sizeof(float)), *out_f = malloc(n * sizeof(float));
+	double *labs = malloc(6 * N_COLORS * sizeof(double));
+	float *labs_f = malloc(6 * N_COLORS * sizeof(float));
+	if (!in || !out || !expected || !in_f || !out_f || !labs || !labs_f) {
+		perror("Delta E 2000");
+		return 4;
+	}
+	uint64_t s = 0x2545F4914F6CDD1DULL;
+	for (size_t i = 0; i < n; ++i) {
+		in[i] = uniform(&s, 0.0, 100.0), in[i + n] = uniform(&s, -128.0, 128.0), in[i + 2 * n] = uniform(&s, -128.0, 128.0);
+		in[i + 3 * n] = uniform(&s, 0.0, 100.0), in[i + 4 * n] = uniform(&s, -128.0, 128.0), in[i + 5 * n] = uniform(&s, -128.0, 128.0);
+		for (int k = 0; k < 6; ++k)
+			in_f[i + k * n] = (float) in[i + k * n];
+		expected[i] = ciede_2000(in[i], in[i + n], in[i + 2 * n], in[i + 3 * n], in[i + 4 * n], in[i + 5 * n]);
+	}
+	// The palettes of the one-to-many and matrix entry points are the first 2 x 1000 colors, as triples.
+	for (size_t i = 0; i < 2 * N_COLORS; ++i)
+		for (int k = 0; k < 3; ++k)
+			labs[3 * i + k] = in[i + k * n], labs_f[3 * i + k] = in_f[i + k * n];
+
+	printf("====== libciede2000 %s (header %s) ======\n", ciede2000_version(), CIEDE2000_VERSION);
+	printf("Code path     : %s\n", ciede2000_path());
+	printf("Configuration : %s\n", ciede2000_config());
+	printf("Pairs         : %zu\n\n", n);
+	printf("%-24s %-14s %s\n", "Entry point", "Max dev.", "Pairs per second");
+
+	double max_deviation = 0.0, max_deviation_f = 0.0, t, d;
+	int n_failures = 0;
+
+	// The deviation is measured against the reference computed in 64-bit, the 32-bit one being less accurate.
+#define DeltaE_report(name, count, deviation, tolerance) \
+	d = (deviation), t = now() - t, \
+	n_failures += !(d <= (tolerance)), \
+	printf("%-24s %-14.3g %.0f%s\n", name, d, (double) (count) / t, d <= (tolerance) ? "" : "   (FAIL)")
+
+	t = now();
+	for (size_t i = 0; i < n; ++i)
+		out[i] = ciede2000(in[i], in[i + n], in[i + 2 * n], in[i + 3 * n], in[i + 4 * n], in[i + 5 * n]);
+	for (size_t i = 0; i < n; ++i)
+		max_deviation = fmax(max_deviation, fabs(out[i] - expected[i]));
+	DeltaE_report("ciede2000", n, max_deviation, 1E-10);
+
+	t = now();
+	ciede2000_batch(n, in, in + n, in + 2 * n, in + 3 * n, in + 4 * n, in + 5 * n, out);
+	max_deviation = 0.0;
+	for (size_t i = 0; i < n; ++i)
+		max_deviation = fmax(max_deviation, fabs(out[i] - expected[i]));
+	DeltaE_report("ciede2000_batch", n, max_deviation, 1E-10);
+
+	t = now();
+	for (size_t i = 0; i < n; ++i)
+		out_f[i] = ciede2000f(in_f[i], in_f[i + n], in_f[i + 2 * n], in_f[i + 3 * n], in_f[i + 4 * n], in_f[i + 5 * n]);
+	for (size_t i = 0; i < n; ++i)
+		max_deviation_f = fmax(max_deviation_f, fabs(out_f[i] - expected[i]));
+	DeltaE_report("ciede2000f", n, max_deviation_f, 1E-2);
+
+	t = now();
+	ciede2000f_batch(n, in_f, in_f + n, in_f + 2 * n, in_f + 3 * n, in_f + 4 * n, in_f + 5 * n, out_f);
+	max_deviation_f = 0.0;
+	for (size_t i = 0; i < n; ++i)
+		max_deviation_f = fmax(max_deviation_f, fabs(out_f[i] - expected[i]));
+	DeltaE_report("ciede2000f_batch", n, max_deviation_f, 1E-2);
+
+	// The matrix is compared with the scalar function of the library, on the first 1000 x 1000 colors.
+	t = now();
+	ciede2000_matrix(N_COLORS, labs, N_COLORS, labs + 3 * N_COLORS, out);
+	max_deviation = 0.0;
+	for (size_t i = 0; i < N_COLORS; ++i)
+		for (size_t j = 0; j < N_COLORS; ++j) {
+			const double *x = labs + 3 * i, *y = labs + 3 * (N_COLORS + j);
+			max_deviation = fmax(max_deviation, fabs(out[i * N_COLORS + j] - ciede_2000(x[0], x[1], x[2], y[0], y[1], y[2])));
+		}
+	DeltaE_report("ciede2000_matrix", N_COLORS * N_COLORS, max_deviation, 1E-10);
+
+	t = now();
+	ciede2000f_matrix(N_COLORS, labs_f, N_COLORS, labs_f + 3 * N_COLORS, out_f);
+	max_deviation_f = 0.0;
+	for (size_t i = 0; i < N_COLORS; ++i)
+		for (size_t j = 0; j < N_COLORS; ++j) {
+			const double *x = labs + 3 * i, *y = labs + 3 * (N_COLORS + j);
+			max_deviation_f = fmax(max_deviation_f, fabs(out_f[i * N_COLORS + j] - ciede_2000(x[0], x[1], x[2], y[0], y[1], y[2])));
+		}
+	DeltaE_report("ciede2000f_matrix", N_COLORS * N_COLORS, max_deviation_f, 1E-2);
+
+	// One color against the whole palette, the first color being compared with itself.
+	t = now();
+	ciede2000_one_to_many(labs, 2 * N_COLORS, labs, out);
+	max_deviation = out[0];
+	for (size_t i = 0; i < 2 * N_COLORS; ++i)
+		max_deviation = fmax(max_deviation, fabs(out[i] - ciede_2000(labs[0], labs[1], labs[2], labs[3 * i], labs[3 * i + 1], labs[3 * i + 2])));
+	DeltaE_report("ciede2000_one_to_many", 2 * N_COLORS, max_deviation, 1E-10);
+
+	t = now();
+	ciede2000f_one_to_many(labs_f, 2 * N_COLORS, labs_f, out_f);
+	max_deviation_f = out_f[0];
+	for (size_t i = 0; i < 2 * N_COLORS; ++i)
+		max_deviation_f = fmax(max_deviation_f, fabs(out_f[i] - ciede_2000(labs[0], labs[1], labs[2], labs[3 * i], labs[3 * i + 1], labs[3 * i + 2])));
+	DeltaE_report("ciede2000f_one_to_many", 2 * N_COLORS, max_deviation_f, 1E-2);
+#undef DeltaE_report
+
+	n_failures += strcmp(ciede2000_version(), CIEDE2000_VERSION) != 0;
+	// Loading the library must leave the floating-point environment of the process as it was.
+	volatile double subnormal = DBL_MIN;
+	subnormal /= 4.0;
+	if (subnormal == 0.0)
+		++n_failures, printf("\n  - FAIL : Loading the library flushes the subnormal numbers to zero\n");
+	if (n_failures)
+		printf("\n  - FAIL : %d entry points of the library deviate from the reference\n", n_failures);
+	else
+		printf("\n  - PASS : Every entry point of the library matches the reference\n");
+	free(in), free(out), free(expected), free(in_f), free(out_f), free(labs), free(labs_f);
+	return n_failures != 0;
+}
+
+// The compilation of the library, then of this program, is done using GCC or CLang :
+// - gcc -std=c99 -Wall -Wextra -pedantic -O3 -ffast-math -mno-recip -fPIC -fvisibility=hidden -c -o libciede2000.o libciede2000.c
+// - gcc -shared -o libciede2000.so libciede2000.o -lm
+// - gcc -std=c11 -Wall -Wextra -pedantic -O2 -o libciede2000-test libciede2000-test.c -L. -lciede2000 -lm
+// Finally, the execution is done using LD_LIBRARY_PATH=. ./libciede2000-test
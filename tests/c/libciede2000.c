@@ -0,0 +1,670 @@
+// This library written in C is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#include "libciede2000.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338328
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+static double ciede_2000(const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2) {
+	// Working in C with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const double k_l = 1.0;
+	const double k_c = 1.0;
+	const double k_h = 1.0;
+	double n = (sqrt(a_1 * a_1 + b_1 * b_1) + sqrt(a_2 * a_2 + b_2 * b_2)) * 0.5;
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = 1.0 + 0.5 * (1.0 - sqrt(n / (n + 6103515625.0)));
+	// Application of the chroma correction factor.
+	const double c_1 = sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const double c_2 = sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	double h_1 = atan2(b_1, a_1 * n);
+	double h_2 = atan2(b_2, a_2 * n);
+	h_1 += (h_1 < 0.0) * 2.0 * M_PI;
+	h_2 += (h_2 < 0.0) * 2.0 * M_PI;
+	n = fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (M_PI - 1E-14 < n && n < M_PI + 1E-14)
+		n = M_PI;
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	double h_m = (h_1 + h_2) * 0.5;
+	double h_d = (h_2 - h_1) * 0.5;
+	h_d += (M_PI < n) * M_PI;
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (M_PI < n) * M_PI;
+	// h_m += (M_PI < n) * ((h_m < M_PI) - (M_PI <= h_m)) * M_PI;
+	const double p = 36.0 * h_m - 55.0 * M_PI;
+	n = (c_1 + c_2) * 0.5;
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const double r_t = -2.0 * sqrt(n / (n + 6103515625.0))
+			* sin(M_PI / 3.0 * exp(p * p / (-25.0 * M_PI * M_PI)));
+	n = (l_1 + l_2) * 0.5;
+	n = (n - 50.0) * (n - 50.0);
+	// Lightness.
+	const double l = (l_2 - l_1) / (k_l * (1.0 + 0.015 * n / sqrt(20.0 + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const double t = 1.0	+ 0.24 * sin(2.0 * h_m + M_PI / 2.0)
+				+ 0.32 * sin(3.0 * h_m + 8.0 * M_PI / 15.0)
+				- 0.17 * sin(h_m + M_PI / 3.0)
+				- 0.20 * sin(4.0 * h_m + 3.0 * M_PI / 20.0);
+	n = c_1 + c_2;
+	// Hue.
+	const double h = 2.0 * sqrt(c_1 * c_2) * sin(h_d) / (k_h * (1.0 + 0.0075 * n * t));
+	// Chroma.
+	const double c = (c_2 - c_1) / (k_c * (1.0 + 0.0225 * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+static float ciede_2000f(const float l_1, const float a_1, const float b_1, const float l_2, const float a_2, const float b_2) {
+	// Working in C with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const float k_l = 1.0f;
+	const float k_c = 1.0f;
+	const float k_h = 1.0f;
+	float n = (sqrtf(a_1 * a_1 + b_1 * b_1) + sqrtf(a_2 * a_2 + b_2 * b_2)) * 0.5f;
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = 1.0f + 0.5f * (1.0f - sqrtf(n / (n + 6103515625.0f)));
+	// Application of the chroma correction factor.
+	const float c_1 = sqrtf(a_1 * a_1 * n * n + b_1 * b_1);
+	const float c_2 = sqrtf(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	float h_1 = atan2f(b_1, a_1 * n);
+	float h_2 = atan2f(b_2, a_2 * n);
+	h_1 += (h_1 < 0.0f) * 2.0f * (float)M_PI;
+	h_2 += (h_2 < 0.0f) * 2.0f * (float)M_PI;
+	// 32-bit implementations do not have consistent rounding between implementations.
+	n = fabsf(h_2 - h_1);
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	float h_m = (h_1 + h_2) * 0.5f;
+	float h_d = (h_2 - h_1) * 0.5f;
+	h_d += ((float)M_PI < n) * (float)M_PI;
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += ((float)M_PI < n) * (float)M_PI;
+	// h_m += ((float)M_PI < n) * ((h_m < (float)M_PI) - ((float)M_PI <= h_m)) * (float)M_PI;
+	const float p = 36.0f * h_m - 55.0f * (float)M_PI;
+	n = (c_1 + c_2) * 0.5f;
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const float r_t = -2.0f * sqrtf(n / (n + 6103515625.0f)) * sinf((float)M_PI / 3.0f
+					* expf(p * p / (-25.0f * (float)M_PI * (float)M_PI)));
+	n = (l_1 + l_2) * 0.5f;
+	n = (n - 50.0f) * (n - 50.0f);
+	// Lightness.
+	const float l = (l_2 - l_1) / (k_l * (1.0f + 0.015f * n / sqrtf(20.0f + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const float t = 1.0f	+ 0.24f * sinf(2.0f * h_m + (float)M_PI / 2.0f)
+				+ 0.32f * sinf(3.0f * h_m + 8.0f * (float)M_PI / 15.0f)
+				- 0.17f * sinf(h_m + (float)M_PI / 3.0f)
+				- 0.20f * sinf(4.0f * h_m + 3.0f * (float)M_PI / 20.0f);
+	n = c_1 + c_2;
+	// Hue.
+	const float h = 2.0f * sqrtf(c_1 * c_2) * sinf(h_d) / (k_h * (1.0f + 0.0075f * n * t));
+	// Chroma.
+	const float c = (c_2 - c_1) / (k_c * (1.0f + 0.0225f * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return sqrtf(l * l + h * h + c * c + c * h * r_t);
+}
+
+#if defined(__GNUC__)
+#define CIEDE2000_INLINE inline __attribute__((always_inline))
+#else
+#define CIEDE2000_INLINE inline
+#endif
+
+// The batch CIE ΔE2000 implementation, which operates on arrays of L*a*b* colors, and stores their differences.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+static CIEDE2000_INLINE void ciede_2000_batch(const size_t len, const double *restrict l_1, const double *restrict a_1, const double *restrict b_1, const double *restrict l_2, const double *restrict a_2, const double *restrict b_2, double *restrict delta_e) {
+	// Working in C with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const double k_l = 1.0;
+	const double k_c = 1.0;
+	const double k_h = 1.0;
+	// The loop body is free of branches, so that the compiler can vectorize it.
+	for (size_t i = 0; i < len; ++i) {
+		double n = (sqrt(a_1[i] * a_1[i] + b_1[i] * b_1[i]) + sqrt(a_2[i] * a_2[i] + b_2[i] * b_2[i])) * 0.5;
+		n = n * n * n * n * n * n * n;
+		// A factor involving chroma raised to the power of 7 designed to make
+		// the influence of chroma on the total color difference more accurate.
+		n = 1.0 + 0.5 * (1.0 - sqrt(n / (n + 6103515625.0)));
+		// Application of the chroma correction factor.
+		const double c_1 = sqrt(a_1[i] * a_1[i] * n * n + b_1[i] * b_1[i]);
+		const double c_2 = sqrt(a_2[i] * a_2[i] * n * n + b_2[i] * b_2[i]);
+		// atan2 is preferred over atan because it accurately computes the angle of
+		// a point (x, y) in all quadrants, handling the signs of both coordinates.
+		double h_1 = atan2(b_1[i], a_1[i] * n);
+		double h_2 = atan2(b_2[i], a_2[i] * n);
+		h_1 += (h_1 < 0.0) * 2.0 * M_PI;
+		h_2 += (h_2 < 0.0) * 2.0 * M_PI;
+		n = fabs(h_2 - h_1);
+		// Cross-implementation consistent rounding.
+		n = M_PI - 1E-14 < n && n < M_PI + 1E-14 ? M_PI : n;
+		// When the hue angles lie in different quadrants, the straightforward
+		// average can produce a mean that incorrectly suggests a hue angle in
+		// the wrong quadrant, the next lines handle this issue.
+		double h_m = (h_1 + h_2) * 0.5;
+		double h_d = (h_2 - h_1) * 0.5;
+		h_d += (M_PI < n) * M_PI;
+		// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+		// and these two variants differ by ±0.0003 on the final color differences.
+		h_m += (M_PI < n) * M_PI;
+		// h_m += (M_PI < n) * ((h_m < M_PI) - (M_PI <= h_m)) * M_PI;
+		const double p = 36.0 * h_m - 55.0 * M_PI;
+		n = (c_1 + c_2) * 0.5;
+		n = n * n * n * n * n * n * n;
+		// The hue rotation correction term is designed to account for the
+		// non-linear behavior of hue differences in the blue region.
+		const double r_t = -2.0 * sqrt(n / (n + 6103515625.0))
+				* sin(M_PI / 3.0 * exp(p * p / (-25.0 * M_PI * M_PI)));
+		n = (l_1[i] + l_2[i]) * 0.5;
+		n = (n - 50.0) * (n - 50.0);
+		// Lightness.
+		const double l = (l_2[i] - l_1[i]) / (k_l * (1.0 + 0.015 * n / sqrt(20.0 + n)));
+		// These coefficients adjust the impact of different harmonic
+		// components on the hue difference calculation.
+		const double t = 1.0	+ 0.24 * sin(2.0 * h_m + M_PI / 2.0)
+					+ 0.32 * sin(3.0 * h_m + 8.0 * M_PI / 15.0)
+					- 0.17 * sin(h_m + M_PI / 3.0)
+					- 0.20 * sin(4.0 * h_m + 3.0 * M_PI / 20.0);
+		n = c_1 + c_2;
+		// Hue.
+		const double h = 2.0 * sqrt(c_1 * c_2) * sin(h_d) / (k_h * (1.0 + 0.0075 * n * t));
+		// Chroma.
+		const double c = (c_2 - c_1) / (k_c * (1.0 + 0.0225 * n));
+		// Returning the square root ensures that dE00 accurately reflects the
+		// geometric distance in color space, which can range from 0 to around 185.
+		delta_e[i] = sqrt(l * l + h * h + c * c + c * h * r_t);
+	}
+}
+
+// The same batch implementation in 32-bit.
+static CIEDE2000_INLINE void ciede_2000f_batch(const size_t len, const float *restrict l_1, const float *restrict a_1, const float *restrict b_1, const float *restrict l_2, const float *restrict a_2, const float *restrict b_2, float *restrict delta_e) {
+	// Working in C with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const float k_l = 1.0f;
+	const float k_c = 1.0f;
+	const float k_h = 1.0f;
+	// The loop body is free of branches, so that the compiler can vectorize it.
+	for (size_t i = 0; i < len; ++i) {
+		float n = (sqrtf(a_1[i] * a_1[i] + b_1[i] * b_1[i]) + sqrtf(a_2[i] * a_2[i] + b_2[i] * b_2[i])) * 0.5f;
+		n = n * n * n * n * n * n * n;
+		// A factor involving chroma raised to the power of 7 designed to make
+		// the influence of chroma on the total color difference more accurate.
+		n = 1.0f + 0.5f * (1.0f - sqrtf(n / (n + 6103515625.0f)));
+		// Application of the chroma correction factor.
+		const float c_1 = sqrtf(a_1[i] * a_1[i] * n * n + b_1[i] * b_1[i]);
+		const float c_2 = sqrtf(a_2[i] * a_2[i] * n * n + b_2[i] * b_2[i]);
+		// atan2 is preferred over atan because it accurately computes the angle of
+		// a point (x, y) in all quadrants, handling the signs of both coordinates.
+		float h_1 = atan2f(b_1[i], a_1[i] * n);
+		float h_2 = atan2f(b_2[i], a_2[i] * n);
+		h_1 += (h_1 < 0.0f) * 2.0f * (float) M_PI;
+		h_2 += (h_2 < 0.0f) * 2.0f * (float) M_PI;
+		// 32-bit implementations do not have consistent rounding between implementations.
+		n = fabsf(h_2 - h_1);
+		// When the hue angles lie in different quadrants, the straightforward
+		// average can produce a mean that incorrectly suggests a hue angle in
+		// the wrong quadrant, the next lines handle this issue.
+		float h_m = (h_1 + h_2) * 0.5f;
+		float h_d = (h_2 - h_1) * 0.5f;
+		h_d += ((float) M_PI < n) * (float) M_PI;
+		// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+		// and these two variants differ by ±0.0003 on the final color differences.
+		h_m += ((float) M_PI < n) * (float) M_PI;
+		// h_m += ((float) M_PI < n) * ((h_m < (float) M_PI) - ((float) M_PI <= h_m)) * (float) M_PI;
+		const float p = 36.0f * h_m - 55.0f * (float) M_PI;
+		n = (c_1 + c_2) * 0.5f;
+		n = n * n * n * n * n * n * n;
+		// The hue rotation correction term is designed to account for the
+		// non-linear behavior of hue differences in the blue region.
+		const float r_t = -2.0f * sqrtf(n / (n + 6103515625.0f))
+				* sinf((float) M_PI / 3.0f * expf(p * p / (-25.0f * (float) M_PI * (float) M_PI)));
+		n = (l_1[i] + l_2[i]) * 0.5f;
+		n = (n - 50.0f) * (n - 50.0f);
+		// Lightness.
+		const float l = (l_2[i] - l_1[i]) / (k_l * (1.0f + 0.015f * n / sqrtf(20.0f + n)));
+		// These coefficients adjust the impact of different harmonic
+		// components on the hue difference calculation.
+		const float t = 1.0f	+ 0.24f * sinf(2.0f * h_m + (float) M_PI / 2.0f)
+					+ 0.32f * sinf(3.0f * h_m + 8.0f * (float) M_PI / 15.0f)
+					- 0.17f * sinf(h_m + (float) M_PI / 3.0f)
+					- 0.20f * sinf(4.0f * h_m + 3.0f * (float) M_PI / 20.0f);
+		n = c_1 + c_2;
+		// Hue.
+		const float h = 2.0f * sqrtf(c_1 * c_2) * sinf(h_d) / (k_h * (1.0f + 0.0075f * n * t));
+		// Chroma.
+		const float c = (c_2 - c_1) / (k_c * (1.0f + 0.0225f * n));
+		// Returning the square root ensures that dE00 accurately reflects the
+		// geometric distance in color space, which can range from 0 to around 185.
+		delta_e[i] = sqrtf(l * l + h * h + c * c + c * h * r_t);
+	}
+}
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////   Shared Library and Dispatch   ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// The batch kernels above are compiled once per code path, through wrappers whose "target" attribute lets the
+// compiler use the corresponding instructions. Compiled with -ffast-math, GCC vectorizes the loops by calling the
+// vector mathematical functions of the glibc (libmvec), in 2, 4 or 8 lanes of 64-bit. When the library is
+// loaded, a constructor queries the processor (CPUID) and selects the fastest path it supports. The link must
+// not use -ffast-math, which would add "crtfastmath.o", whose constructor flushes the subnormal numbers to zero
+// in the whole process loading the library, so the object file is compiled first, then linked without it. On
+// x86, GCC also computes the vectorized sqrtf with RSQRTPS under -ffast-math, which returns NaN for subnormal
+// numbers, such as the squares of the chromas below 1E-19 in 32-bit, hence the -mno-recip option of GCC.
+
+// Which configuration is the fastest also depends on the processor : the code path, whether the 64-bit
+// functions may compute in 32-bit (twice the lanes, when the tolerance allows it), and the size of the blocks
+// gathered on the stack. The tuner measures each of them on color pairs shaped like real-world workloads, and
+// saves the winner in a cache file, so that the next processes load it without measuring anything.
+
+#define BLOCK 256
+#define MAX_BLOCK 1024
+
+typedef void (*batch_double)(size_t, const double *, const double *, const double *, const double *, const double *, const double *, double *);
+typedef void (*batch_float)(size_t, const float *, const float *, const float *, const float *, const float *, const float *, float *);
+
+struct code_path {
+	const char *name;
+	batch_double kernel;
+	batch_float kernel_f;
+	batch_double kernel_narrow;
+};
+
+// The "narrow" kernels serve the 64-bit functions by converting the colors to 32-bit, block by block.
+#define DeltaE_path(name, attributes) \
+	static attributes void batch_##name(size_t n, const double *l_1, const double *a_1, const double *b_1, const double *l_2, const double *a_2, const double *b_2, double *delta_e) { \
+		ciede_2000_batch(n, l_1, a_1, b_1, l_2, a_2, b_2, delta_e); \
+	} \
+	static attributes void batch_f_##name(size_t n, const float *l_1, const float *a_1, const float *b_1, const float *l_2, const float *a_2, const float *b_2, float *delta_e) { \
+		ciede_2000f_batch(n, l_1, a_1, b_1, l_2, a_2, b_2, delta_e); \
+	} \
+	static attributes void batch_narrow_##name(size_t n, const double *l_1, const double *a_1, const double *b_1, const double *l_2, const double *a_2, const double *b_2, double *delta_e) { \
+		float soa[7][BLOCK]; \
+		for (size_t i = 0; i < n; i += BLOCK) { \
+			const size_t len = n - i < BLOCK ? n - i : BLOCK; \
+			for (size_t k = 0; k < len; ++k) { \
+				soa[0][k] = (float) l_1[i + k], soa[1][k] = (float) a_1[i + k], soa[2][k] = (float) b_1[i + k]; \
+				soa[3][k] = (float) l_2[i + k], soa[4][k] = (float) a_2[i + k], soa[5][k] = (float) b_2[i + k]; \
+			} \
+			ciede_2000f_batch(len, soa[0], soa[1], soa[2], soa[3], soa[4], soa[5], soa[6]); \
+			for (size_t k = 0; k < len; ++k) \
+				delta_e[i + k] = soa[6][k]; \
+		} \
+	}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CIEDE2000_X86
+DeltaE_path(sse2, )
+DeltaE_path(avx2, __attribute__((target("avx2,fma"))))
+DeltaE_path(avx512, __attribute__((target("avx512f"))))
+#else
+DeltaE_path(generic, )
+#endif
+#undef DeltaE_path
+
+static const struct code_path paths[] = {
+#ifdef CIEDE2000_X86
+	{"avx512", batch_avx512, batch_f_avx512, batch_narrow_avx512},
+	{"avx2", batch_avx2, batch_f_avx2, batch_narrow_avx2},
+	{"sse2", batch_sse2, batch_f_sse2, batch_narrow_sse2},
+#else
+	{"generic", batch_generic, batch_f_generic, batch_narrow_generic},
+#endif
+};
+
+static const size_t block_sizes[] = {64, 256, 1024};
+
+// The configuration in use, where "narrow" means that the 64-bit functions compute in 32-bit.
+struct tuning {
+	const struct code_path *path;
+	int narrow;
+	size_t block;
+};
+
+static struct tuning active = {0, 0, BLOCK};
+
+static char description[64];
+
+static int is_supported(const struct code_path *path) {
+#ifdef CIEDE2000_X86
+	// The processor reports its features, and whether the operating system saves the wider registers.
+	__builtin_cpu_init();
+	if (!strcmp(path->name, "avx512"))
+		return __builtin_cpu_supports("avx512f");
+	if (!strcmp(path->name, "avx2"))
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+	// SSE2 is part of the x86-64 baseline, and the generic path runs anywhere.
+	return 1;
+}
+
+static void describe(const struct tuning *tuning, char *buffer) {
+	sprintf(buffer, "%s %s %u", tuning->path->name, tuning->narrow ? "float" : "double", (unsigned) tuning->block);
+}
+
+static void activate(const struct tuning *tuning) {
+	active = *tuning;
+	describe(&active, description);
+}
+
+static const struct code_path *find_path(const char *name) {
+	for (size_t i = 0; i < sizeof(paths) / sizeof(*paths); ++i)
+		if (!strcmp(name, paths[i].name) && is_supported(&paths[i]))
+			return &paths[i];
+	return 0;
+}
+
+static void select_path(void) {
+	// The fastest supported path, unless the environment requests a slower one (for tests, or a rollback), which
+	// may be followed by "float" for the 32-bit computation of the 64-bit functions (e.g. "sse2 float").
+	const char *requested = getenv("CIEDE2000_PATH");
+	char name[16], precision[8] = "";
+	struct tuning tuning = {0, 0, BLOCK};
+	if (requested && 0 < sscanf(requested, "%15s %7s", name, precision))
+		tuning.path = find_path(name), tuning.narrow = !strcmp(precision, "float");
+	for (size_t i = 0; !tuning.path; ++i)
+		if (is_supported(&paths[i]))
+			tuning.path = &paths[i];
+	activate(&tuning);
+}
+
+// Columns : ΔE2000, then the mean and standard deviation of |ΔL|, |Δa| and |Δb|, some rows of the statistics
+// of 100 billion random pairs, available in "tests/datasets/stats/delta-e-2000-lab-stats-100B-pairs.txt".
+static const double lab_stats[8][7] = {
+	{0.5, 0.318, 0.1938, 1.088, 0.7327, 1.139, 0.8231},
+	{1.0, 0.6684, 0.4026, 2.25, 1.506, 2.361, 1.686},
+	{2.0, 1.366, 0.8211, 4.531, 3.022, 4.735, 3.353},
+	{3.0, 2.069, 1.237, 6.702, 4.471, 6.994, 4.913},
+	{5.0, 3.466, 2.06, 10.79, 7.193, 11.23, 7.772},
+	{8.0, 5.543, 3.269, 16.39, 10.89, 17.02, 11.55},
+	{12.0, 8.273, 4.837, 22.98, 15.23, 23.91, 15.87},
+	{19.9, 13.47, 7.789, 33.84, 22.45, 35.55, 22.73},
+};
+
+#define TUNING_PAIRS 4096
+#define TUNING_PASSES 8
+#define TUNING_TRIALS 3
+
+static uint64_t xor_random(uint64_t *s) {
+	return *s ^= *s << 13, *s ^= *s >> 7, *s ^= *s << 17;
+}
+
+static double rand_unit(uint64_t *s) {
+	return (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double rand_normal(uint64_t *s) {
+	// Box-Muller transform, the first uniform number is kept away from zero.
+	const double u = 1.0 - rand_unit(s), v = rand_unit(s);
+	return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static void synthetic_pairs(const size_t n, double *restrict soa) {
+	// A standard color, plus a perturbation drawn for a ΔE2000 of one of the rows, each component with a random sign.
+	uint64_t s = 0x9E3779B97F4A7C15ULL;
+	for (size_t i = 0; i < n; ++i) {
+		const double *row = lab_stats[xor_random(&s) % (sizeof(lab_stats) / sizeof(*lab_stats))];
+		soa[i] = 100.0 * rand_unit(&s);
+		soa[i + n] = 256.0 * rand_unit(&s) - 128.0;
+		soa[i + 2 * n] = 256.0 * rand_unit(&s) - 128.0;
+		for (int k = 0; k < 3; ++k) {
+			const double delta = fabs(row[1 + 2 * k] + row[2 + 2 * k] * rand_normal(&s));
+			soa[i + (3 + k) * n] = soa[i + k * n] + (xor_random(&s) >> 63 ? -delta : delta);
+		}
+		soa[i + 3 * n] = soa[i + 3 * n] < 0.0 ? 0.0 : 100.0 < soa[i + 3 * n] ? 100.0 : soa[i + 3 * n];
+	}
+}
+
+static void run_blocks(const struct tuning *tuning, const size_t n, const double *soa, double *delta_e) {
+	// The workload of ciede2000_one_to_many, whose colors are gathered in blocks on the stack.
+	double block[6][MAX_BLOCK];
+	const batch_double kernel = tuning->narrow ? tuning->path->kernel_narrow : tuning->path->kernel;
+	for (size_t i = 0; i < n; i += tuning->block) {
+		const size_t len = n - i < tuning->block ? n - i : tuning->block;
+		for (int k = 0; k < 6; ++k)
+			memcpy(block[k], soa + k * n + i, len * sizeof(double));
+		kernel(len, block[0], block[1], block[2], block[3], block[4], block[5], delta_e + i);
+	}
+}
+
+static void cpu_model(char *model) {
+	strcpy(model, "unknown");
+#ifdef CIEDE2000_X86
+	// The brand string, such as "Intel(R) Xeon(R) Platinum 8370C CPU @ 2.80GHz", given in 3 times 16 bytes.
+	unsigned int regs[12];
+	if (__get_cpuid_max(0x80000000, 0) < 0x80000004)
+		return;
+	for (unsigned int i = 0; i < 3; ++i)
+		__get_cpuid(0x80000002 + i, &regs[4 * i], &regs[4 * i + 1], &regs[4 * i + 2], &regs[4 * i + 3]);
+	memcpy(model, regs, 48);
+	model[48] = 0;
+	char *start = model;
+	while (*start == ' ')
+		++start;
+	memmove(model, start, strlen(start) + 1);
+	for (size_t len = strlen(model); len && model[len - 1] == ' '; --len)
+		model[len - 1] = 0;
+#endif
+	for (char *c = model; *c; ++c)
+		if (*c == '\t' || *c == '\n')
+			*c = ' ';
+}
+
+static int read_cache(const char *cache_file, const char *key, struct tuning *tuning) {
+	// Each line of the cache is a key and a configuration separated by a tab, the processors may differ.
+	char line[256], name[16], precision[8];
+	unsigned block;
+	FILE *fp = fopen(cache_file, "r");
+	int found = 0;
+	if (!fp)
+		return 0;
+	while (!found && fgets(line, sizeof(line), fp)) {
+		const size_t len = strlen(key);
+		if (strncmp(line, key, len) || line[len] != '\t' || sscanf(line + len + 1, "%15s %7s %u", name, precision, &block) != 3)
+			continue;
+		tuning->path = find_path(name);
+		tuning->narrow = !strcmp(precision, "float");
+		tuning->block = block;
+		for (size_t i = 0; i < sizeof(block_sizes) / sizeof(*block_sizes); ++i)
+			found |= tuning->path && block == block_sizes[i];
+	}
+	fclose(fp);
+	return found;
+}
+
+static void write_cache(const char *cache_file, const char *key, const struct tuning *tuning) {
+	char config[64];
+	FILE *fp = fopen(cache_file, "a");
+	if (!fp)
+		return;
+	describe(tuning, config);
+	fprintf(fp, "%s\t%s\n", key, config);
+	fclose(fp);
+}
+
+const char *ciede2000_autotune(const char *cache_file, double tolerance) {
+	char key[128], model[49];
+	struct tuning tuning, best = active;
+	cpu_model(model);
+	sprintf(key, "%s;%s;%.3g", model, CIEDE2000_VERSION, tolerance);
+	if (cache_file && read_cache(cache_file, key, &tuning)) {
+		activate(&tuning);
+		return description;
+	}
+	double *soa = malloc(8 * TUNING_PAIRS * sizeof(double)), *reference = soa + 6 * TUNING_PAIRS, *delta_e = soa + 7 * TUNING_PAIRS;
+	if (!soa)
+		return description;
+	synthetic_pairs(TUNING_PAIRS, soa);
+	for (size_t i = 0; i < TUNING_PAIRS; ++i)
+		reference[i] = ciede_2000(soa[i], soa[i + TUNING_PAIRS], soa[i + 2 * TUNING_PAIRS], soa[i + 3 * TUNING_PAIRS], soa[i + 4 * TUNING_PAIRS], soa[i + 5 * TUNING_PAIRS]);
+	double best_time = HUGE_VAL;
+	for (size_t i = 0; i < sizeof(paths) / sizeof(*paths); ++i)
+		for (int narrow = 0; narrow < 2 && is_supported(&paths[i]); ++narrow)
+			for (size_t j = 0; j < sizeof(block_sizes) / sizeof(*block_sizes); ++j) {
+				tuning.path = &paths[i], tuning.narrow = narrow, tuning.block = block_sizes[j];
+				// The accuracy gate, a configuration deviating from the reference by more than the tolerance is discarded.
+				run_blocks(&tuning, TUNING_PAIRS, soa, delta_e);
+				int accurate = 1;
+				for (size_t k = 0; k < TUNING_PAIRS; ++k)
+					accurate &= fabs(delta_e[k] - reference[k]) <= tolerance;
+				if (!accurate)
+					continue;
+				// The best of a few trials is kept, which filters out the interruptions of the process.
+				for (int trial = 0; trial < TUNING_TRIALS; ++trial) {
+					const clock_t start = clock();
+					for (int pass = 0; pass < TUNING_PASSES; ++pass)
+						run_blocks(&tuning, TUNING_PAIRS, soa, delta_e);
+					const double time = (double) (clock() - start) / CLOCKS_PER_SEC;
+					if (time < best_time)
+						best_time = time, best = tuning;
+				}
+			}
+	free(soa);
+	activate(&best);
+	if (cache_file)
+		write_cache(cache_file, key, &best);
+	return description;
+}
+
+#ifdef __GNUC__
+__attribute__((constructor))
+#endif
+static void initialize(void) {
+	// The configuration comes from the CPUID, or from the tuner when CIEDE2000_TUNE names its cache file.
+	const char *cache_file = getenv("CIEDE2000_TUNE"), *tolerance = getenv("CIEDE2000_TOLERANCE");
+	select_path();
+	if (cache_file && !getenv("CIEDE2000_PATH"))
+		ciede2000_autotune(cache_file, tolerance ? strtod(tolerance, 0) : 1E-10);
+}
+
+static const struct tuning *tuning(void) {
+	// Without the constructor (a static link with another compiler), the selection happens on the first call.
+	if (!active.path)
+		initialize();
+	return &active;
+}
+
+double ciede2000(double l_1, double a_1, double b_1, double l_2, double a_2, double b_2) {
+	return ciede_2000(l_1, a_1, b_1, l_2, a_2, b_2);
+}
+
+float ciede2000f(float l_1, float a_1, float b_1, float l_2, float a_2, float b_2) {
+	return ciede_2000f(l_1, a_1, b_1, l_2, a_2, b_2);
+}
+
+void ciede2000_batch(size_t n, const double *l_1, const double *a_1, const double *b_1, const double *l_2, const double *a_2, const double *b_2, double *delta_e) {
+	const struct tuning *t = tuning();
+	(t->narrow ? t->path->kernel_narrow : t->path->kernel)(n, l_1, a_1, b_1, l_2, a_2, b_2, delta_e);
+}
+
+void ciede2000f_batch(size_t n, const float *l_1, const float *a_1, const float *b_1, const float *l_2, const float *a_2, const float *b_2, float *delta_e) {
+	tuning()->path->kernel_f(n, l_1, a_1, b_1, l_2, a_2, b_2, delta_e);
+}
+
+void ciede2000_one_to_many(const double *lab, size_t n, const double *labs, double *delta_e) {
+	// The triples are gathered in blocks of arrays on the stack, the first color being repeated.
+	double soa[6][MAX_BLOCK];
+	const struct tuning *t = tuning();
+	const batch_double kernel = t->narrow ? t->path->kernel_narrow : t->path->kernel;
+	const size_t block = t->block;
+	for (size_t k = 0; k < block; ++k)
+		soa[0][k] = lab[0], soa[1][k] = lab[1], soa[2][k] = lab[2];
+	for (size_t i = 0; i < n; i += block) {
+		const size_t len = n - i < block ? n - i : block;
+		for (size_t k = 0; k < len; ++k)
+			soa[3][k] = labs[3 * (i + k)], soa[4][k] = labs[3 * (i + k) + 1], soa[5][k] = labs[3 * (i + k) + 2];
+		kernel(len, soa[0], soa[1], soa[2], soa[3], soa[4], soa[5], delta_e + i);
+	}
+}
+
+void ciede2000f_one_to_many(const float *lab, size_t n, const float *labs, float *delta_e) {
+	float soa[6][MAX_BLOCK];
+	const struct tuning *t = tuning();
+	const batch_float kernel = t->path->kernel_f;
+	const size_t block = t->block;
+	for (size_t k = 0; k < block; ++k)
+		soa[0][k] = lab[0], soa[1][k] = lab[1], soa[2][k] = lab[2];
+	for (size_t i = 0; i < n; i += block) {
+		const size_t len = n - i < block ? n - i : block;
+		for (size_t k = 0; k < len; ++k)
+			soa[3][k] = labs[3 * (i + k)], soa[4][k] = labs[3 * (i + k) + 1], soa[5][k] = labs[3 * (i + k) + 2];
+		kernel(len, soa[0], soa[1], soa[2], soa[3], soa[4], soa[5], delta_e + i);
+	}
+}
+
+void ciede2000_matrix(size_t n_1, const double *labs_1, size_t n_2, const double *labs_2, double *delta_e) {
+	for (size_t i = 0; i < n_1; ++i)
+		ciede2000_one_to_many(labs_1 + 3 * i, n_2, labs_2, delta_e + i * n_2);
+}
+
+void ciede2000f_matrix(size_t n_1, const float *labs_1, size_t n_2, const float *labs_2, float *delta_e) {
+	for (size_t i = 0; i < n_1; ++i)
+		ciede2000f_one_to_many(labs_1 + 3 * i, n_2, labs_2, delta_e + i * n_2);
+}
+
+const char *ciede2000_path(void) {
+	return tuning()->path->name;
+}
+
+const char *ciede2000_config(void) {
+	tuning();
+	return description;
+}
+
+const char *ciede2000_version(void) {
+	return CIEDE2000_VERSION;
+}
+
+// The compilation of the shared library is done using GCC or CLang :
+// - gcc -std=c99 -Wall -Wextra -pedantic -O3 -ffast-math -mno-recip -fPIC -fvisibility=hidden -c -o libciede2000.o libciede2000.c
+//   (-mno-recip being an x86 option, which the other processors don't need)
+//   gcc -shared -o libciede2000.so libciede2000.o -lm
+// - clang -std=c99 -Wall -Wextra -pedantic -O3 -ffast-math -fPIC -fvisibility=hidden -c -o libciede2000.o libciede2000.c
+//   clang -shared -o libciede2000.so libciede2000.o -lm
+// Then a program includes "libciede2000.h" and is linked using -L. -lciede2000
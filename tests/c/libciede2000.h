@@ -0,0 +1,72 @@
+// This header written in C is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#ifndef LIBCIEDE2000_H
+#define LIBCIEDE2000_H
+
+// The C interface of libciede2000, a shared library of the CIE ΔE2000 color difference, which selects at load
+// time the fastest code path supported by the processor (AVX-512, AVX2 or SSE2 on x86). Callers link against
+// the library instead of copying the function, so that they benefit from its improvements without recompiling.
+
+// The colors are L*a*b* triples, "l" ranging from 0 to 100, "a" and "b" being commonly clamped to -128..127.
+// The results differ from the reference function of ciede-2000.c by less than 1E-10 in 64-bit.
+
+#include <stddef.h>
+
+#define CIEDE2000_VERSION "1.1.0"
+#define CIEDE2000_VERSION_NUMBER 10100
+
+#if defined(_WIN32)
+#define CIEDE2000_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#define CIEDE2000_API __attribute__((visibility("default")))
+#else
+#define CIEDE2000_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The ΔE2000 between two colors.
+CIEDE2000_API double ciede2000(double l_1, double a_1, double b_1, double l_2, double a_2, double b_2);
+CIEDE2000_API float ciede2000f(float l_1, float a_1, float b_1, float l_2, float a_2, float b_2);
+
+// For each "i" below n, delta_e[i] receives the ΔE2000 between (l_1[i], a_1[i], b_1[i]) and (l_2[i], a_2[i], b_2[i]).
+CIEDE2000_API void ciede2000_batch(size_t n, const double *l_1, const double *a_1, const double *b_1, const double *l_2, const double *a_2, const double *b_2, double *delta_e);
+CIEDE2000_API void ciede2000f_batch(size_t n, const float *l_1, const float *a_1, const float *b_1, const float *l_2, const float *a_2, const float *b_2, float *delta_e);
+
+// The "lab" color is compared to the n colors of "labs", given as consecutive triples (L, a, b, L, a, b, ...).
+CIEDE2000_API void ciede2000_one_to_many(const double *lab, size_t n, const double *labs, double *delta_e);
+CIEDE2000_API void ciede2000f_one_to_many(const float *lab, size_t n, const float *labs, float *delta_e);
+
+// Each of the n_1 colors of "labs_1" is compared to each of the n_2 colors of "labs_2", the results being stored
+// in row-major order : delta_e[i * n_2 + j] is the ΔE2000 between the i-th color of labs_1 and the j-th of labs_2.
+CIEDE2000_API void ciede2000_matrix(size_t n_1, const double *labs_1, size_t n_2, const double *labs_2, double *delta_e);
+CIEDE2000_API void ciede2000f_matrix(size_t n_1, const float *labs_1, size_t n_2, const float *labs_2, float *delta_e);
+
+// The code path in use : "avx512", "avx2", "sse2" or "generic". The environment variable CIEDE2000_PATH,
+// read when the library is loaded, can request a slower path supported by the processor (e.g. "sse2"), and
+// the 32-bit computation of the 64-bit functions, whose results then stay within 1E-3 (e.g. "sse2 float").
+CIEDE2000_API const char *ciede2000_path(void);
+
+// The configuration in use, such as "avx2 double 256" : the code path, the precision of the computations behind
+// the 64-bit functions, and the number of colors per block in ciede2000_one_to_many and ciede2000_matrix.
+CIEDE2000_API const char *ciede2000_config(void);
+
+// Measures the configurations supported by the processor on synthetic color pairs, and switches to the fastest
+// whose results stay within "tolerance" of the reference (1E-10 keeps 64-bit computations, 1E-3 allows 32-bit).
+// The winner is appended to "cache_file" (unless NULL), under a key made of the CPU model, the version of the
+// library and the tolerance, so that the next calls read it instead of measuring. It takes about 0.1 second,
+// and should not run while other threads use the library. When CIEDE2000_TUNE names a cache file, it's called
+// at load time, with the tolerance given by CIEDE2000_TOLERANCE (1E-10 by default). Returns ciede2000_config().
+CIEDE2000_API const char *ciede2000_autotune(const char *cache_file, double tolerance);
+
+// The version of the loaded library, which can be compared to the CIEDE2000_VERSION of this header.
+CIEDE2000_API const char *ciede2000_version(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,347 @@
+// This function written in C++ is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#include <cmath>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327950288419716939937511
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+template<typename T>
+static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2) {
+	// Working in C++ with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+	// Application of the chroma correction factor.
+	const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	T h_1 = std::atan2(b_1, a_1 * n);
+	T h_2 = std::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+	n = std::fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
+		n = T(M_PI);
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	T h_m = (h_1 + h_2) * T(0.5);
+	T h_d = (h_2 - h_1) * T(0.5);
+	h_d += (T(M_PI) < n) * T(M_PI);
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (T(M_PI) < n) * T(M_PI);
+	// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+	const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+	n = (c_1 + c_2) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0)))
+			* std::sin(T(M_PI) / T(3.0) * std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI))));
+	n = (l_1 + l_2) * T(0.5);
+	n = (n - T(50.0)) * (n - T(50.0));
+	// Lightness.
+	const T l = (l_2 - l_1) / (k_l * (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+				- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+	n = c_1 + c_2;
+	// Hue.
+	const T h = T(2.0) * std::sqrt(c_1 * c_2) * std::sin(h_d) / (k_h * (T(1.0) + T(3.0) / T(400.0) * n * t));
+	// Chroma.
+	const T c = (c_2 - c_1) / (k_c * (T(1.0) + T(9.0) / T(400.0) * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 96.5   a1 = 47.8   b1 = 4.6
+// L2 = 96.8   a2 = 53.2   b2 = -4.1
+// CIE ΔE00 = 4.6680978034 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 4.6680847226 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.3e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////         Accuracy Tiers          ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// The consumers of ΔE2000 don't need the same accuracy : about 1E-2 for the previews of a user interface, 1E-4
+// for the quality control of prints, and the full 64-bit for calibration. Each tier maps to a kernel, the Exact
+// tier being ciede_2000<double>, and the others replacing atan2, sin and exp with low-degree polynomials :
+// - Fast, in 32-bit, whose tested maximum error is 3E-3 (contract 1E-2), at least 3x the throughput of float
+// - Balanced, in 64-bit, whose tested maximum error is 1E-5 (contract 1E-4)
+// These errors exclude the pairs whose hues are π apart within 1E-4 radian, where the mean hue jumps by π and
+// the ΔE2000 is discontinuous, so that any approximation can pick either side.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+enum class accuracy { fast, balanced, exact };
+
+namespace ciede_2000_accuracy_detail {
+
+	template<accuracy A>
+	struct tier;
+
+	// The coefficients are near-minimax fits : atan(x) / x and sin(x) / x as polynomials of x², and exp(-u).
+	template<>
+	struct tier<accuracy::fast> {
+		using type = float;
+		static constexpr const char *name = "Fast";
+		static constexpr double contract = 1E-2;
+		static constexpr float atan[] = {0.9998663f, -0.330304379f, 0.180157787f, -0.0851542977f, 0.0208441876f};
+		static constexpr float sin[] = {0.999996616f, -0.166648284f, 0.00830632515f, -0.000183636521f};
+		static constexpr float exp[] = {0.999997444f, -0.999875173f, 0.498946858f, -0.163267323f, 0.0364753915f, -0.00439865763f};
+		static constexpr float hue_band = 1E-6f;
+	};
+
+	template<>
+	struct tier<accuracy::balanced> {
+		using type = double;
+		static constexpr const char *name = "Balanced";
+		static constexpr double contract = 1E-4;
+		static constexpr double atan[] = {0.999999336, -0.333298625, 0.199465829, -0.139087088, 0.0964238537, -0.0559147289, 0.0218645266, -0.00405497824};
+		static constexpr double sin[] = {1.0, -0.166666666, 0.00833332987, -0.000198407591, 2.75211363e-06, -2.38282978e-08};
+		static constexpr double exp[] = {0.999999994, -0.99999951, 0.499992929, -0.166626094, 0.0415485729, -0.0081409151, 0.00120849774, -0.000104033535};
+		static constexpr double hue_band = 1E-14;
+	};
+
+	// The polynomial c[0] + c[1] * x + ..., unrolled at compile time.
+	template<size_t I = 0, typename T, size_t N>
+	inline T horner(const T (&c)[N], const T x) {
+		if constexpr (I + 1 == N)
+			return c[I];
+		else
+			return c[I] + x * horner<I + 1>(c, x);
+	}
+
+	// The branches are selects, so that the batch kernels vectorize.
+	template<accuracy A, typename T = typename tier<A>::type>
+	inline T atan2(const T y, const T x) {
+		const T pi = T(3.14159265358979323846), ax = std::fabs(x), ay = std::fabs(y);
+		const T z = std::min(ax, ay) / std::max(std::max(ax, ay), T(1E-30)), z_2 = z * z;
+		T r = z * horner(tier<A>::atan, z_2);
+		r = ax < ay ? pi * T(0.5) - r : r;
+		r = x < T(0.0) ? pi - r : r;
+		return y < T(0.0) ? -r : r;
+	}
+
+	template<accuracy A, typename T = typename tier<A>::type>
+	inline T sin(T x) {
+		const T pi = T(3.14159265358979323846);
+		// The arguments are within ±64 turns, so that a truncation (which vectorizes) is the floor.
+		x -= T(2.0) * pi * (T(int(x * (T(0.5) / pi) + T(64.5))) - T(64.0));
+		x = pi * T(0.5) < x ? pi - x : x < -pi * T(0.5) ? -pi - x : x;
+		return x * horner(tier<A>::sin, x * x);
+	}
+
+	template<accuracy A, typename T = typename tier<A>::type>
+	inline T exp_negative(const T q) {
+		// exp(-q) = exp(-q / 32) ^ 32, and exp(-40) is negligible in the rotation term.
+		T r = horner(tier<A>::exp, std::min(q, T(40.0)) * T(1.0 / 32.0));
+		r *= r, r *= r, r *= r, r *= r;
+		return r * r;
+	}
+
+	// The ciede_2000 template, with the polynomial functions of the tier, inlined in the batch kernels.
+	template<accuracy A, typename T = typename tier<A>::type>
+	[[gnu::always_inline]] inline T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2) {
+		const T pi = T(3.14159265358979323846);
+		T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+		n = n * n * n * n * n * n * n;
+		n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+		const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+		const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+		T h_1 = atan2<A>(b_1, a_1 * n);
+		T h_2 = atan2<A>(b_2, a_2 * n);
+		h_1 += (h_1 < T(0.0)) * T(2.0) * pi;
+		h_2 += (h_2 < T(0.0)) * T(2.0) * pi;
+		n = std::fabs(h_2 - h_1);
+		n = pi - tier<A>::hue_band < n && n < pi + tier<A>::hue_band ? pi : n;
+		T h_m = (h_1 + h_2) * T(0.5);
+		T h_d = (h_2 - h_1) * T(0.5);
+		h_d += (pi < n) * pi;
+		h_m += (pi < n) * pi;
+		const T p = T(36.0) * h_m - T(55.0) * pi;
+		n = (c_1 + c_2) * T(0.5);
+		n = n * n * n * n * n * n * n;
+		const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0))) * sin<A>(pi / T(3.0) * exp_negative<A>(p * p / (T(25.0) * pi * pi)));
+		n = (l_1 + l_2) * T(0.5);
+		n = (n - T(50.0)) * (n - T(50.0));
+		const T l = (l_2 - l_1) / (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n));
+		const T t = T(1.0) + T(6.0) / T(25.0) * sin<A>(T(2.0) * h_m + pi / T(2.0))
+				+ T(8.0) / T(25.0) * sin<A>(T(3.0) * h_m + T(8.0) * pi / T(15.0))
+				- T(17.0) / T(100.0) * sin<A>(h_m + pi / T(3.0))
+				- T(1.0) / T(5.0) * sin<A>(T(4.0) * h_m + T(3.0) * pi / T(20.0));
+		n = c_1 + c_2;
+		const T h = T(2.0) * std::sqrt(c_1 * c_2) * sin<A>(h_d) / (T(1.0) + T(3.0) / T(400.0) * n * t);
+		const T c = (c_2 - c_1) / (T(1.0) + T(9.0) / T(400.0) * n);
+		return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+	}
+}
+
+// The ΔE2000 of a pair at the given accuracy, such as ciede_2000<accuracy::fast>(l_1, a_1, b_1, l_2, a_2, b_2).
+template<accuracy A>
+static double ciede_2000(const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2) {
+	if constexpr (A == accuracy::exact)
+		return ciede_2000<double>(l_1, a_1, b_1, l_2, a_2, b_2);
+	else {
+		using T = typename ciede_2000_accuracy_detail::tier<A>::type;
+		return (double) ciede_2000_accuracy_detail::ciede_2000<A>((T) l_1, (T) a_1, (T) b_1, (T) l_2, (T) a_2, (T) b_2);
+	}
+}
+
+// The batch kernel of a tier, on arrays of its precision (float for Fast, double otherwise).
+template<accuracy A, typename T = std::conditional_t<A == accuracy::fast, float, double>>
+static void ciede_2000(const size_t n, const T *l_1, const T *a_1, const T *b_1, const T *l_2, const T *a_2, const T *b_2, T *delta_e) {
+	for (size_t i = 0; i < n; ++i)
+		if constexpr (A == accuracy::exact)
+			delta_e[i] = ciede_2000<double>(l_1[i], a_1[i], b_1[i], l_2[i], a_2[i], b_2[i]);
+		else
+			delta_e[i] = ciede_2000_accuracy_detail::ciede_2000<A>(l_1[i], a_1[i], b_1[i], l_2[i], a_2[i], b_2[i]);
+}
+
+static inline uint64_t xor_random(uint64_t &s) {
+	return s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+}
+
+static inline double uniform(uint64_t &s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+template<typename F>
+static double seconds(const F &f) {
+	const auto t_1 = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t_1).count();
+}
+
+// The distance between π and the hue difference of a pair, in 64-bit.
+static double hue_jump(const double *c) {
+	double n = (std::sqrt(c[1] * c[1] + c[2] * c[2]) + std::sqrt(c[4] * c[4] + c[5] * c[5])) * 0.5;
+	n = n * n * n * n * n * n * n;
+	n = 1.0 + 0.5 * (1.0 - std::sqrt(n / (n + 6103515625.0)));
+	double h_1 = std::atan2(c[2], c[1] * n), h_2 = std::atan2(c[5], c[4] * n);
+	h_1 += (h_1 < 0.0) * 2.0 * M_PI;
+	h_2 += (h_2 < 0.0) * 2.0 * M_PI;
+	return std::fabs(std::fabs(h_2 - h_1) - M_PI);
+}
+
+template<accuracy A>
+static double max_error(const std::vector<double> &pairs, size_t &n_jumps) {
+	double worst = 0.0;
+	n_jumps = 0;
+	for (size_t i = 0; i < pairs.size(); i += 6) {
+		const double *c = &pairs[i];
+		if (hue_jump(c) < 1E-4)
+			++n_jumps;
+		else
+			worst = std::max(worst, std::fabs(ciede_2000<A>(c[0], c[1], c[2], c[3], c[4], c[5]) - ciede_2000<double>(c[0], c[1], c[2], c[3], c[4], c[5])));
+	}
+	return worst;
+}
+
+int main(int argc, char *argv[]) {
+	// Usage : ./ciede-2000-accuracy [number of pairs] [seed]
+	const long parsed_n = 1 < argc ? std::strtol(argv[1], nullptr, 10) : 0;
+	const size_t n = parsed_n < 1 ? 2000000 : (size_t) parsed_n;
+	const uint64_t parsed_seed = std::strtoull(2 < argc ? argv[2] : "0", nullptr, 10);
+	uint64_t s = parsed_seed ? parsed_seed : (uint64_t) std::chrono::system_clock::now().time_since_epoch().count() | 1;
+
+	// Random pairs, close pairs, opposite hues and rounded achromatic colors.
+	std::vector<double> pairs(6 * n);
+	for (size_t i = 0; i < n; ++i) {
+		double *c = &pairs[6 * i];
+		c[0] = uniform(s, 0.0, 100.0), c[1] = uniform(s, -128.0, 128.0), c[2] = uniform(s, -128.0, 128.0);
+		switch (i & 3) {
+		case 0 :
+			c[3] = uniform(s, 0.0, 100.0), c[4] = uniform(s, -128.0, 128.0), c[5] = uniform(s, -128.0, 128.0);
+			break;
+		case 1 :
+			c[3] = c[0] + uniform(s, -0.5, 0.5), c[4] = c[1] + uniform(s, -0.5, 0.5), c[5] = c[2] + uniform(s, -0.5, 0.5);
+			break;
+		case 2 :
+			c[3] = uniform(s, 0.0, 100.0), c[4] = -c[1] * uniform(s, 0.1, 2.0) + uniform(s, -1E-3, 1E-3), c[5] = -c[2] * uniform(s, 0.1, 2.0);
+			break;
+		default :
+			for (int k = 0; k < 6; ++k)
+				c[k] = std::round((k % 3 ? uniform(s, -2.0, 2.0) : uniform(s, 0.0, 100.0)) * 10.0) / 10.0;
+		}
+	}
+	size_t n_jumps;
+	const double error_fast = max_error<accuracy::fast>(pairs, n_jumps);
+	const double error_balanced = max_error<accuracy::balanced>(pairs, n_jumps);
+	const double error_exact = max_error<accuracy::exact>(pairs, n_jumps);
+
+	// The throughputs are measured by the batch kernels, on arrays of the precision of each kernel.
+	const size_t m = std::min<size_t>(n, 1 << 20);
+	std::vector<float> f(7 * m);
+	std::vector<double> d(7 * m);
+	for (size_t i = 0; i < m; ++i)
+		for (int k = 0; k < 6; ++k)
+			f[k * m + i] = (float) pairs[6 * i + k], d[k * m + i] = pairs[6 * i + k];
+	float *x = f.data();
+	double *y = d.data();
+	const double t_float = seconds([&] {
+		for (size_t i = 0; i < m; ++i)
+			x[6 * m + i] = ciede_2000<float>(x[i], x[m + i], x[2 * m + i], x[3 * m + i], x[4 * m + i], x[5 * m + i]);
+	});
+	const double t_fast = seconds([&] { ciede_2000<accuracy::fast>(m, x, x + m, x + 2 * m, x + 3 * m, x + 4 * m, x + 5 * m, x + 6 * m); });
+	const double t_balanced = seconds([&] { ciede_2000<accuracy::balanced>(m, y, y + m, y + 2 * m, y + 3 * m, y + 4 * m, y + 5 * m, y + 6 * m); });
+	const double t_exact = seconds([&] { ciede_2000<accuracy::exact>(m, y, y + m, y + 2 * m, y + 3 * m, y + 4 * m, y + 5 * m, y + 6 * m); });
+
+	std::printf("Compared %zu color pairs with ciede_2000<double>, %zu of them being within 1E-4 radian of the hue jump.\n\n", n, n_jumps);
+	std::printf("%-10s %10s %10s %14s %10s\n", "Tier", "Max error", "Contract", "Pairs/s", "vs float");
+	std::printf("%-10s %10s %10s %14.4g %10.2f\n", "(float)", "", "", (double) m / t_float, 1.0);
+	std::printf("%-10s %10.2e %10.0e %14.4g %10.2f\n", "Fast", error_fast, 1E-2, (double) m / t_fast, t_float / t_fast);
+	std::printf("%-10s %10.2e %10.0e %14.4g %10.2f\n", "Balanced", error_balanced, 1E-4, (double) m / t_balanced, t_float / t_balanced);
+	std::printf("%-10s %10.2e %10.0e %14.4g %10.2f\n\n", "Exact", error_exact, 1E-10, (double) m / t_exact, t_float / t_exact);
+
+	const bool accurate = error_fast <= 1E-2 && error_balanced <= 1E-4 && error_exact <= 1E-10;
+	const bool fast = 3.0 * t_fast <= t_float;
+	if (accurate)
+		std::printf("  - PASS : Each tier meets its accuracy contract\n");
+	else
+		std::printf("  - FAIL : A tier exceeds its accuracy contract\n");
+	if (fast)
+		std::printf("  - PASS : The Fast tier is at least 3x faster than float\n");
+	else
+		std::printf("  - FAIL : The Fast tier is less than 3x faster than float\n");
+	return !(accurate && fast);
+}
+
+// The compilation is done using GCC or CLang, -march=native and -fno-trapping-math letting the batch kernels vectorize :
+// - g++ -std=c++17 -Wall -Wextra -pedantic -O3 -march=native -fno-math-errno -fno-trapping-math -o ciede-2000-accuracy ciede-2000-accuracy.cpp
+// - clang++ -std=c++17 -Wall -Wextra -pedantic -O3 -march=native -fno-math-errno -fno-trapping-math -o ciede-2000-accuracy ciede-2000-accuracy.cpp
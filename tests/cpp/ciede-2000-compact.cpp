@@ -0,0 +1,358 @@
+// This function written in C++ is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#include <cmath>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327950288419716939937511
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+template<typename T>
+static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2) {
+	// Working in C++ with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+	// Application of the chroma correction factor.
+	const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	T h_1 = std::atan2(b_1, a_1 * n);
+	T h_2 = std::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+	n = std::fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
+		n = T(M_PI);
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	T h_m = (h_1 + h_2) * T(0.5);
+	T h_d = (h_2 - h_1) * T(0.5);
+	h_d += (T(M_PI) < n) * T(M_PI);
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (T(M_PI) < n) * T(M_PI);
+	// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+	const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+	n = (c_1 + c_2) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0)))
+			* std::sin(T(M_PI) / T(3.0) * std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI))));
+	n = (l_1 + l_2) * T(0.5);
+	n = (n - T(50.0)) * (n - T(50.0));
+	// Lightness.
+	const T l = (l_2 - l_1) / (k_l * (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+				- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+	n = c_1 + c_2;
+	// Hue.
+	const T h = T(2.0) * std::sqrt(c_1 * c_2) * std::sin(h_d) / (k_h * (T(1.0) + T(3.0) / T(400.0) * n * t));
+	// Chroma.
+	const T c = (c_2 - c_1) / (k_c * (T(1.0) + T(9.0) / T(400.0) * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 96.5   a1 = 47.8   b1 = 4.6
+// L2 = 96.8   a2 = 53.2   b2 = -4.1
+// CIE ΔE00 = 4.6680978034 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 4.6680847226 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.3e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////      Compact L*a*b* Storage     ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// Stores of billions of L*a*b* colors in 64-bit use 24 bytes per color, and their batch processing is bound by
+// the memory bandwidth. The formats below store each channel in 16 bits (6 bytes per color, 4 times less) :
+// - lab_f16 : IEEE 754 half precision, 11 significant bits, so a* = 100 is stored within ±0.03
+// - lab_bf16 : bfloat16, the upper half of a float, 8 significant bits, so a* = 100 is stored within ±0.25
+// - lab_icc : ICC-style fixed point, L* in uint16 over 0..100 (step 0.0015), a* and b* in int16 in 1/256
+// The batch kernel reads the compact arrays and widens each value in registers, right before the ΔE2000 of the
+// pair, so the dataset is never converted up front. The decoding is free of branches (the half precision only
+// handles finite values, which is the case of colors), so that the compiler can vectorize the kernel.
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+// The uncompressed formats, as references for the throughput.
+template<typename S>
+struct lab_native {
+	using l_type = S;
+	using ab_type = S;
+	static l_type encode_l(const double l) { return S(l); }
+	static ab_type encode_ab(const double x) { return S(x); }
+	template<typename T> static T decode_l(const l_type l) { return T(l); }
+	template<typename T> static T decode_ab(const ab_type x) { return T(x); }
+};
+
+using lab_f64 = lab_native<double>;
+using lab_f32 = lab_native<float>;
+
+static inline float float_from_bits(const uint32_t bits) {
+	float f;
+	std::memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
+static inline uint32_t bits_from_float(const float f) {
+	uint32_t bits;
+	std::memcpy(&bits, &f, sizeof(bits));
+	return bits;
+}
+
+struct lab_f16 {
+	using l_type = uint16_t;
+	using ab_type = uint16_t;
+	static uint16_t encode(double x) {
+		// Rounded to the nearest, the values beyond ±65504 becoming infinite.
+		const uint16_t sign = std::signbit(x) ? 0x8000 : 0;
+		x = std::fabs(x);
+		if (!(x < 65520.0))
+			return sign | 0x7C00;
+		int e = x < 0x1p-14 ? -14 : std::ilogb(x);
+		auto m = (uint32_t) std::nearbyint(std::ldexp(x, 10 - e));
+		if (m == 2048)
+			m = 1024, ++e;
+		return m < 1024 ? sign | m : sign | (uint16_t) ((e + 15) << 10) | (uint16_t) (m - 1024);
+	}
+	template<typename T> static T decode(const uint16_t h) {
+		// The exponent and the significand move into place in a float, whose bias (127 instead of 15) is
+		// compensated by a multiplication by 2^112, which also covers the subnormal numbers.
+		const uint32_t bits = (uint32_t) (h & 0x8000) << 16 | (uint32_t) (h & 0x7FFF) << 13;
+		return T(float_from_bits(bits) * 0x1p112f);
+	}
+	static l_type encode_l(const double l) { return encode(l); }
+	static ab_type encode_ab(const double x) { return encode(x); }
+	template<typename T> static T decode_l(const l_type l) { return decode<T>(l); }
+	template<typename T> static T decode_ab(const ab_type x) { return decode<T>(x); }
+};
+
+struct lab_bf16 {
+	using l_type = uint16_t;
+	using ab_type = uint16_t;
+	static uint16_t encode(const double x) {
+		// The upper half of the float, rounded to the nearest even.
+		const uint32_t bits = bits_from_float((float) x);
+		return (uint16_t) ((bits + 0x7FFF + (bits >> 16 & 1)) >> 16);
+	}
+	template<typename T> static T decode(const uint16_t h) {
+		return T(float_from_bits((uint32_t) h << 16));
+	}
+	static l_type encode_l(const double l) { return encode(l); }
+	static ab_type encode_ab(const double x) { return encode(x); }
+	template<typename T> static T decode_l(const l_type l) { return decode<T>(l); }
+	template<typename T> static T decode_ab(const ab_type x) { return decode<T>(x); }
+};
+
+struct lab_icc {
+	using l_type = uint16_t;
+	using ab_type = int16_t;
+	static l_type encode_l(const double l) {
+		return (l_type) std::nearbyint(std::min(std::max(l, 0.0), 100.0) * (65535.0 / 100.0));
+	}
+	static ab_type encode_ab(const double x) {
+		return (ab_type) std::nearbyint(std::min(std::max(x * 256.0, -32768.0), 32767.0));
+	}
+	template<typename T> static T decode_l(const l_type l) { return T(l) * T(100.0 / 65535.0); }
+	template<typename T> static T decode_ab(const ab_type x) { return T(x) * T(1.0 / 256.0); }
+};
+
+// The colors of a compact store, as a structure of arrays.
+template<typename Format>
+struct lab_store {
+	std::vector<typename Format::l_type> l;
+	std::vector<typename Format::ab_type> a, b;
+	explicit lab_store(const size_t n = 0) : l(n), a(n), b(n) {}
+	void set(const size_t i, const double l_value, const double a_value, const double b_value) {
+		l[i] = Format::encode_l(l_value), a[i] = Format::encode_ab(a_value), b[i] = Format::encode_ab(b_value);
+	}
+	size_t bytes_per_color() const { return sizeof(typename Format::l_type) + 2 * sizeof(typename Format::ab_type); }
+};
+
+// For each "i" below len, delta_e[i] receives the ΔE2000, computed using T, between the colors of index i in
+// the stores 1 and 2. The loop body is free of branches, so that the compiler can vectorize it.
+template<typename Format, typename T>
+static void ciede_2000_batch(const size_t len, const lab_store<Format> &store_1, const lab_store<Format> &store_2, T *delta_e) {
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	const auto *L_1 = store_1.l.data(), *L_2 = store_2.l.data();
+	const auto *A_1 = store_1.a.data(), *A_2 = store_2.a.data();
+	const auto *B_1 = store_1.b.data(), *B_2 = store_2.b.data();
+	for (size_t i = 0; i < len; ++i) {
+		// The values are widened here, in registers.
+		const T l_1 = Format::template decode_l<T>(L_1[i]), a_1 = Format::template decode_ab<T>(A_1[i]), b_1 = Format::template decode_ab<T>(B_1[i]);
+		const T l_2 = Format::template decode_l<T>(L_2[i]), a_2 = Format::template decode_ab<T>(A_2[i]), b_2 = Format::template decode_ab<T>(B_2[i]);
+		T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+		n = n * n * n * n * n * n * n;
+		n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+		const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+		const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+		T h_1 = std::atan2(b_1, a_1 * n);
+		T h_2 = std::atan2(b_2, a_2 * n);
+		h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+		h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+		n = std::fabs(h_2 - h_1);
+		n = T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14) ? T(M_PI) : n;
+		T h_m = (h_1 + h_2) * T(0.5);
+		T h_d = (h_2 - h_1) * T(0.5);
+		h_d += (T(M_PI) < n) * T(M_PI);
+		h_m += (T(M_PI) < n) * T(M_PI);
+		// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+		const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+		n = (c_1 + c_2) * T(0.5);
+		n = n * n * n * n * n * n * n;
+		const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0)))
+				* std::sin(T(M_PI) / T(3.0) * std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI))));
+		n = (l_1 + l_2) * T(0.5);
+		n = (n - T(50.0)) * (n - T(50.0));
+		const T l = (l_2 - l_1) / (k_l * (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n)));
+		const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+					+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+					- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+					- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+		n = c_1 + c_2;
+		const T h = T(2.0) * std::sqrt(c_1 * c_2) * std::sin(h_d) / (k_h * (T(1.0) + T(3.0) / T(400.0) * n * t));
+		const T c = (c_2 - c_1) / (k_c * (T(1.0) + T(9.0) / T(400.0) * n));
+		delta_e[i] = std::sqrt(l * l + h * h + c * c + c * h * r_t);
+	}
+}
+
+// The distance of the hue difference to π, positive when the formula adds π to the mean hue. The ΔE2000 is
+// discontinuous there (by up to 50 units at high chroma), so a pair whose hues are close to π apart can switch
+// sides once rounded to 16 bits, or be decided otherwise by a 32-bit kernel. Such pairs are counted separately.
+static double hues_wrap(const double a_1, const double b_1, const double a_2, const double b_2) {
+	double n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * 0.5;
+	n = n * n * n * n * n * n * n;
+	n = 1.0 + 0.5 * (1.0 - std::sqrt(n / (n + 6103515625.0)));
+	double h_1 = std::atan2(b_1, a_1 * n), h_2 = std::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < 0.0) * 2.0 * M_PI;
+	h_2 += (h_2 < 0.0) * 2.0 * M_PI;
+	return std::fabs(h_2 - h_1) - M_PI;
+}
+
+static inline uint64_t xor_random(uint64_t &s) {
+	return s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+}
+
+static inline double uniform(uint64_t &s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+template<typename F>
+static double seconds(const F &f) {
+	const auto t_1 = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t_1).count();
+}
+
+struct sample {
+	std::vector<double> l_1, a_1, b_1, l_2, a_2, b_2, expected;
+};
+
+template<typename Format, typename T>
+static void measure(const char *name, const char *type, const sample &pairs) {
+	const size_t n = pairs.expected.size();
+	lab_store<Format> store_1(n), store_2(n);
+	for (size_t i = 0; i < n; ++i) {
+		store_1.set(i, pairs.l_1[i], pairs.a_1[i], pairs.b_1[i]);
+		store_2.set(i, pairs.l_2[i], pairs.a_2[i], pairs.b_2[i]);
+	}
+	std::vector<T> delta_e(n);
+	double best = HUGE_VAL;
+	for (int trial = 0; trial < 3; ++trial)
+		best = std::min(best, seconds([&] { ciede_2000_batch(n, store_1, store_2, delta_e.data()); }));
+	// The deviation is measured against ciede_2000<double> on the original values, before the encoding.
+	double max_deviation = 0.0, sum_deviation = 0.0;
+	size_t worst = 0, n_wraps = 0;
+	for (size_t i = 0; i < n; ++i) {
+		const double deviation = std::fabs((double) delta_e[i] - pairs.expected[i]);
+		const double wraps = hues_wrap(pairs.a_1[i], pairs.b_1[i], pairs.a_2[i], pairs.b_2[i]);
+		const double decoded = hues_wrap(Format::template decode_ab<double>(store_1.a[i]), Format::template decode_ab<double>(store_1.b[i]), Format::template decode_ab<double>(store_2.a[i]), Format::template decode_ab<double>(store_2.b[i]));
+		if ((0.0 < wraps) != (0.0 < decoded) || std::fabs(decoded) < (sizeof(T) < 8 ? 1E-5 : 1E-13)) {
+			++n_wraps;
+			continue;
+		}
+		sum_deviation += deviation;
+		if (max_deviation < deviation)
+			max_deviation = deviation, worst = i;
+	}
+	std::printf("%-8s %-8s %-7zu %-13.3g %-13.3g %-10zu %-8.2f %.0f\n", name, type, store_1.bytes_per_color(), max_deviation, sum_deviation / (double) (n - n_wraps), n_wraps, (double) n * 2.0 * (double) store_1.bytes_per_color() / best * 1E-9, (double) n / best);
+	if (getenv("VERBOSE"))
+		std::printf("         worst pair : %.17g,%.17g,%.17g,%.17g,%.17g,%.17g\n", pairs.l_1[worst], pairs.a_1[worst], pairs.b_1[worst], pairs.l_2[worst], pairs.a_2[worst], pairs.b_2[worst]);
+}
+
+int main(int argc, char *argv[]) {
+	// Usage : ./ciede-2000-compact [number of pairs] [seed]
+	const long parsed_n = 1 < argc ? std::strtol(argv[1], nullptr, 10) : 0;
+	const size_t n = parsed_n < 1000 ? 4000000 : (size_t) parsed_n;
+	const uint64_t parsed_seed = std::strtoull(2 < argc ? argv[2] : "0", nullptr, 10);
+	uint64_t s = parsed_seed ? parsed_seed : (uint64_t) std::chrono::system_clock::now().time_since_epoch().count() | 1;
+	// Half of the pairs are random colors, the other half are pairs of close colors (ΔE2000 of about 0 to 5), in
+	// the range of the ICC format.
+	sample pairs;
+	for (auto *v : {&pairs.l_1, &pairs.a_1, &pairs.b_1, &pairs.l_2, &pairs.a_2, &pairs.b_2, &pairs.expected})
+		v->resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		pairs.l_1[i] = uniform(s, 0.0, 100.0), pairs.a_1[i] = uniform(s, -128.0, 127.99), pairs.b_1[i] = uniform(s, -128.0, 127.99);
+		if (i & 1)
+			pairs.l_2[i] = std::min(std::max(pairs.l_1[i] + uniform(s, -3.0, 3.0), 0.0), 100.0), pairs.a_2[i] = std::min(std::max(pairs.a_1[i] + uniform(s, -3.0, 3.0), -128.0), 127.99), pairs.b_2[i] = std::min(std::max(pairs.b_1[i] + uniform(s, -3.0, 3.0), -128.0), 127.99);
+		else
+			pairs.l_2[i] = uniform(s, 0.0, 100.0), pairs.a_2[i] = uniform(s, -128.0, 127.99), pairs.b_2[i] = uniform(s, -128.0, 127.99);
+		pairs.expected[i] = ciede_2000<double>(pairs.l_1[i], pairs.a_1[i], pairs.b_1[i], pairs.l_2[i], pairs.a_2[i], pairs.b_2[i]);
+	}
+	std::printf("Compact storage of %zu pairs of L*a*b* colors, compared to ciede_2000<double> on the original values.\n", n);
+	std::printf("%-8s %-8s %-7s %-13s %-13s %-10s %-8s %s\n", "Format", "Kernel", "Bytes", "Max dev.", "Mean dev.", "Wrapping", "GB/s", "Pairs per second");
+	measure<lab_f64, double>("f64", "double", pairs);
+	measure<lab_f32, float>("f32", "float", pairs);
+	measure<lab_f16, double>("f16", "double", pairs);
+	measure<lab_f16, float>("f16", "float", pairs);
+	measure<lab_bf16, double>("bf16", "double", pairs);
+	measure<lab_bf16, float>("bf16", "float", pairs);
+	measure<lab_icc, double>("icc", "double", pairs);
+	measure<lab_icc, float>("icc", "float", pairs);
+	std::printf("The bytes are per color, the GB/s are those of the compact arrays read by the kernel, and the pairs\n");
+	std::printf("whose hues switch sides of π apart once encoded (where ΔE2000 is discontinuous) are left out of the deviations.\n");
+	return 0;
+}
+
+// The compilation is done using GCC or CLang :
+// - g++ -std=c++17 -Wall -Wextra -pedantic -O3 -o ciede-2000-compact ciede-2000-compact.cpp
+// - clang++ -std=c++17 -Wall -Wextra -pedantic -O3 -o ciede-2000-compact ciede-2000-compact.cpp
+// With -Ofast -march=native, GCC vectorizes the kernels, including the widening of the 16-bit values.
@@ -55,7 +55,7 @@ constexpr T ciede_2000(const T l1, const T a1, const T b1, const T l2, const T a
 	const T hue_wrap = T(pi_1 + epsilon < delta_h);
 
 	// The part where most programmers get it wrong
-	const T h_mean = h_mean_raw - T(canonical && pi_1 + epsilon < h_mean_raw ?
+	const T h_mean = h_mean_raw - T(canonical && pi_1 <= h_mean_raw ?
 		1.0 : // canonical=true acts like Gaurav Sharma, OpenJDK, ...
 		-1.0 // canonical=false acts like Bruce Lindbloom, Netflix’s VMAF, ...
 	) * hue_wrap * pi_1;
@@ -121,7 +121,7 @@ constexpr T ciede_2000(const T l1, const T a1, const T b1, const T l2, const T a
 	const T delta_e = std::sqrt(delta_e_squared);
 
 	// The result reflects the actual geometric distance in the color space.
-	// Given a tolerance of 0.00015 in 32 bits.
+	// Given a tolerance of 0.0002 in 32 bits.
 	// Given a tolerance of 3.4e-13 in 64 bits.
 	return delta_e;
 }
@@ -0,0 +1,515 @@
+// This function written in C++ is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#include <cmath>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327950288419716939937511
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+template<typename T>
+static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2) {
+	// Working in C++ with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+	// Application of the chroma correction factor.
+	const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	T h_1 = std::atan2(b_1, a_1 * n);
+	T h_2 = std::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+	n = std::fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
+		n = T(M_PI);
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	T h_m = (h_1 + h_2) * T(0.5);
+	T h_d = (h_2 - h_1) * T(0.5);
+	h_d += (T(M_PI) < n) * T(M_PI);
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (T(M_PI) < n) * T(M_PI);
+	// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+	const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+	n = (c_1 + c_2) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0)))
+			* std::sin(T(M_PI) / T(3.0) * std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI))));
+	n = (l_1 + l_2) * T(0.5);
+	n = (n - T(50.0)) * (n - T(50.0));
+	// Lightness.
+	const T l = (l_2 - l_1) / (k_l * (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+				- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+	n = c_1 + c_2;
+	// Hue.
+	const T h = T(2.0) * std::sqrt(c_1 * c_2) * std::sin(h_d) / (k_h * (T(1.0) + T(3.0) / T(400.0) * n * t));
+	// Chroma.
+	const T c = (c_2 - c_1) / (k_c * (T(1.0) + T(9.0) / T(400.0) * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 96.5   a1 = 47.8   b1 = 4.6
+// L2 = 96.8   a2 = 53.2   b2 = -4.1
+// CIE ΔE00 = 4.6680978034 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 4.6680847226 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.3e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////    Density-Based Clustering     ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// DBSCAN clustering of L*a*b* colors, the neighborhood of a color being the colors within ΔE2000 <= ε of it.
+// A color with at least "min_points" neighbors (itself included) is a core color, the core colors that are
+// neighbors belong to the same cluster, a non-core color joins the cluster of its first core neighbor (in the
+// order of the input), and the others are noise. The neighborhoods are found using the Lab grid and the lower
+// bound of ΔE2000 of ciede-2000-join.cpp, which is exact, so the clusters are those of the O(N²) algorithm.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace ciede_2000_dbscan_detail {
+
+	using color = std::array<double, 3>;
+
+	struct box {
+		color min, max;
+	};
+
+	struct cell {
+		int64_t x, y, z;
+		size_t begin, end; // the colors of the cell, in the sorted order of its grid
+		box bounds;
+		double c_min, c_max; // the chroma range of its colors
+	};
+
+	struct grid {
+		double side;
+		std::vector<size_t> index; // the original index of each color, in the sorted order
+		std::vector<color> colors;
+		std::vector<cell> cells;
+		std::vector<uint64_t> keys; // the sorted keys of the cells, the z coordinate varying the fastest
+	};
+
+	inline uint64_t pack(const int64_t x, const int64_t y, const int64_t z) {
+		// 21 bits per coordinate, which covers any Lab color with cells larger than 0.001.
+		return (uint64_t) (x + (1 << 20)) << 42 | (uint64_t) (y + (1 << 20)) << 21 | (uint64_t) (z + (1 << 20));
+	}
+
+	template<typename It>
+	grid build(It first, const size_t n, const double side) {
+		grid g;
+		g.side = side;
+		std::vector<std::pair<uint64_t, size_t>> keys(n);
+		for (size_t i = 0; i < n; ++i, ++first) {
+			const auto &c = *first;
+			keys[i] = {pack((int64_t) std::floor(c[0] / side), (int64_t) std::floor(c[1] / side), (int64_t) std::floor(c[2] / side)), i};
+			g.colors.push_back({c[0], c[1], c[2]});
+		}
+		std::sort(keys.begin(), keys.end());
+		std::vector<color> sorted(n);
+		g.index.resize(n);
+		for (size_t i = 0; i < n; ++i)
+			g.index[i] = keys[i].second, sorted[i] = g.colors[keys[i].second];
+		g.colors.swap(sorted);
+		for (size_t i = 0; i < n;) {
+			size_t j = i;
+			cell c = {0, 0, 0, i, i, {g.colors[i], g.colors[i]}, 0.0, 0.0};
+			for (; j < n && keys[j].first == keys[i].first; ++j)
+				for (int k = 0; k < 3; ++k)
+					c.bounds.min[k] = std::min(c.bounds.min[k], g.colors[j][k]), c.bounds.max[k] = std::max(c.bounds.max[k], g.colors[j][k]);
+			c.end = j;
+			// The smallest and the largest chroma of the colors of the cell.
+			const box &b = c.bounds;
+			const double gap_a = std::max({0.0, b.min[1], -b.max[1]}), gap_b = std::max({0.0, b.min[2], -b.max[2]});
+			const double far_a = std::max(-b.min[1], b.max[1]), far_b = std::max(-b.min[2], b.max[2]);
+			c.c_min = std::hypot(gap_a, gap_b), c.c_max = std::hypot(far_a, far_b);
+			c.x = (int64_t) (keys[i].first >> 42) - (1 << 20), c.y = (int64_t) (keys[i].first >> 21 & 0x1FFFFF) - (1 << 20), c.z = (int64_t) (keys[i].first & 0x1FFFFF) - (1 << 20);
+			g.keys.push_back(keys[i].first);
+			g.cells.push_back(c);
+			i = j;
+		}
+		return g;
+	}
+
+	inline double s_l(const double l_mean) {
+		const double n = (l_mean - 50.0) * (l_mean - 50.0);
+		return 1.0 + 0.015 * n / std::sqrt(20.0 + n);
+	}
+
+	// The R_C term of the formula, which is also 2 * (1.5 - G) when computed from the mean of the raw chromas.
+	inline double r_c(const double c_mean) {
+		const double c_2 = c_mean * c_mean, n = c_2 * c_2 * c_2 * c_mean;
+		return std::sqrt(n / (n + 6103515625.0));
+	}
+
+	inline double g_factor(const double c_mean) {
+		return 1.5 - 0.5 * r_c(c_mean);
+	}
+
+	// For any color of the cell p and any color of the cell q, ΔE2000² >= k_l * ΔL² + k_ab * (Δa² + Δb²).
+	struct bound {
+		double k_l, k_ab;
+		double operator()(const double d_l, const double d_a, const double d_b) const {
+			return k_l * d_l * d_l + k_ab * (d_a * d_a + d_b * d_b);
+		}
+	};
+
+	inline bound lower_bound(const cell &p, const cell &q) {
+		const double l_low = (p.bounds.min[0] + q.bounds.min[0]) * 0.5, l_high = (p.bounds.max[0] + q.bounds.max[0]) * 0.5;
+		const double worst_s_l = std::max(s_l(l_low), s_l(l_high));
+		const double c_mean_max = g_factor((p.c_min + q.c_min) * 0.5) * (p.c_max + q.c_max) * 0.5;
+		const double worst_s_c = 1.0 + 0.045 * c_mean_max;
+		const double rotation = 1.0 - 0.8660254037844386 * r_c(c_mean_max);
+		return {1.0 / (worst_s_l * worst_s_l), rotation / (worst_s_c * worst_s_c)};
+	}
+
+	// How far in L and in (a, b) a color whose ΔE2000 to some color of the cell is at most τ can lie.
+	inline std::pair<double, double> reach(const cell &p, const double tau) {
+		// The partner's chroma is at least 0, so G is at most g_factor(c_min / 2).
+		const double g = g_factor(p.c_min * 0.5);
+		double r = tau;
+		for (int i = 0; i < 64 && r < 512.0; ++i) {
+			// The partner's chroma is at most c_max + r.
+			const double c_mean_max = g * (p.c_max + r * 0.5);
+			r = tau * (1.0 + 0.045 * c_mean_max) / std::sqrt(1.0 - 0.8660254037844386 * r_c(c_mean_max));
+		}
+		return {tau * s_l(0.0), std::min(r, 512.0)};
+	}
+
+	struct triple {
+		size_t i, j;
+		double delta_e;
+	};
+
+	// Calls visit(i, j) from the threads for each pair of positions i != j in the sorted order of the grid such
+	// that wanted(i, j) and ΔE2000 <= ε, once per pair, the ΔE2000 being computed with the color of smallest
+	// input index first. Asking wanted(i, j) before the ΔE2000 skips the pairs that can no longer matter.
+	template<typename Wanted, typename Visit>
+	void for_each_pair(const grid &g, const double epsilon, const int n_threads, Wanted &&wanted, Visit &&visit) {
+		const double epsilon_2 = epsilon * epsilon * (1.0 + 1E-9);
+		std::atomic<size_t> next_cell(0);
+		const auto work = [&] {
+			for (size_t k; (k = next_cell.fetch_add(1, std::memory_order_relaxed)) < g.cells.size();) {
+				const cell &p = g.cells[k];
+				const auto r = reach(p, epsilon);
+				const int64_t d_l = (int64_t) std::ceil(r.first / g.side), d_ab = (int64_t) std::ceil(r.second / g.side);
+				for (int64_t x = p.x - d_l; x <= p.x + d_l; ++x)
+					for (int64_t y = p.y - d_ab; y <= p.y + d_ab; ++y) {
+						const uint64_t last = pack(x, y, p.z + d_ab);
+						size_t m = (size_t) (std::lower_bound(g.keys.begin(), g.keys.end(), pack(x, y, p.z - d_ab)) - g.keys.begin());
+						for (m = std::max(m, k); m < g.keys.size() && g.keys[m] <= last; ++m) {
+							const cell &q = g.cells[m];
+							const bound lower = lower_bound(p, q);
+							const auto gap = [&](const int c) { return std::max({0.0, q.bounds.min[c] - p.bounds.max[c], p.bounds.min[c] - q.bounds.max[c]}); };
+							if (epsilon_2 < lower(gap(0), gap(1), gap(2)))
+								continue;
+							for (size_t i = p.begin; i < p.end; ++i)
+								for (size_t j = m == k ? i + 1 : q.begin; j < q.end; ++j) {
+									const color *c_1 = &g.colors[i], *c_2 = &g.colors[j];
+									if (epsilon_2 < lower((*c_1)[0] - (*c_2)[0], (*c_1)[1] - (*c_2)[1], (*c_1)[2] - (*c_2)[2]) || !wanted(i, j))
+										continue;
+									if (g.index[j] < g.index[i])
+										std::swap(c_1, c_2);
+									if (ciede_2000<double>((*c_1)[0], (*c_1)[1], (*c_1)[2], (*c_2)[0], (*c_2)[1], (*c_2)[2]) <= epsilon)
+										visit(i, j);
+								}
+						}
+					}
+			}
+		};
+		std::vector<std::thread> threads;
+		for (int i = 1; i < n_threads; ++i)
+			threads.emplace_back(work);
+		work();
+		for (auto &t : threads)
+			t.join();
+	}
+
+	// A union-find shared by the threads without locks : the roots are only modified by a compare-and-swap that
+	// links the larger root under the smaller, and the paths are halved as they are walked.
+	class disjoint_sets {
+		std::vector<std::atomic<uint32_t>> parent;
+
+	public:
+		explicit disjoint_sets(const size_t n) : parent(n) {
+			for (size_t i = 0; i < n; ++i)
+				parent[i].store((uint32_t) i, std::memory_order_relaxed);
+		}
+
+		uint32_t find(uint32_t x) {
+			for (;;) {
+				uint32_t p = parent[x].load(std::memory_order_acquire);
+				if (p == x)
+					return x;
+				const uint32_t q = parent[p].load(std::memory_order_acquire);
+				if (p != q)
+					parent[x].compare_exchange_weak(p, q, std::memory_order_release, std::memory_order_relaxed);
+				x = q;
+			}
+		}
+
+		void unite(uint32_t x, uint32_t y) {
+			for (;;) {
+				x = find(x), y = find(y);
+				if (x == y)
+					return;
+				if (x < y)
+					std::swap(x, y);
+				uint32_t expected = x;
+				if (parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel))
+					return;
+			}
+		}
+	};
+}
+
+// The result of ciede_2000_dbscan : a cluster label (numbered from 0 in the order of the input) or -1 for the
+// noise, and whether the color is a core color, for each color.
+struct ciede_2000_clusters {
+	std::vector<int32_t> label;
+	std::vector<uint8_t> core;
+	int32_t n_clusters;
+};
+
+template<typename It>
+static ciede_2000_clusters ciede_2000_dbscan(It first, const size_t n, const double epsilon, const uint32_t min_points, int n_threads = 0) {
+	using namespace ciede_2000_dbscan_detail;
+	if (n_threads <= 0)
+		n_threads = (int) std::max(1U, std::thread::hardware_concurrency());
+	// The cells are not thinner than the reach in lightness, and are coarsened while they hold less than 2
+	// colors on average, since the clusters are dense but the noise is sparse.
+	grid g = build(first, n, epsilon * s_l(0.0));
+	while (n < 2 * g.cells.size() && g.side < 64.0)
+		g = build(first, n, g.side * 2.0);
+
+	// The first pass counts the neighbors, which identifies the core colors, a count above min_points being
+	// useless.
+	std::vector<std::atomic<uint32_t>> degree(n);
+	for (auto &d : degree)
+		d.store(1, std::memory_order_relaxed);
+	const auto is_core = [&](const size_t i) { return min_points <= degree[i].load(std::memory_order_relaxed); };
+	for_each_pair(g, epsilon, n_threads, [&](const size_t i, const size_t j) { return !is_core(i) || !is_core(j); }, [&](const size_t i, const size_t j) {
+		degree[i].fetch_add(1, std::memory_order_relaxed);
+		degree[j].fetch_add(1, std::memory_order_relaxed);
+	});
+
+	// The second pass unites the core neighbors, and gives each border color the core neighbor of smallest index,
+	// skipping the cores already united and the cores that can't improve the anchor of a border color.
+	disjoint_sets sets(n);
+	std::vector<std::atomic<size_t>> anchor(n);
+	for (auto &a : anchor)
+		a.store(SIZE_MAX, std::memory_order_relaxed);
+	const auto attach = [&](const size_t border, const size_t core) {
+		size_t current = anchor[border].load(std::memory_order_relaxed);
+		while (g.index[core] < current && !anchor[border].compare_exchange_weak(current, g.index[core], std::memory_order_relaxed));
+	};
+	const auto wanted = [&](const size_t i, const size_t j) {
+		const bool core_i = is_core(i), core_j = is_core(j);
+		if (core_i && core_j)
+			return sets.find((uint32_t) i) != sets.find((uint32_t) j);
+		if (core_i)
+			return g.index[i] < anchor[j].load(std::memory_order_relaxed);
+		if (core_j)
+			return g.index[j] < anchor[i].load(std::memory_order_relaxed);
+		return false;
+	};
+	for_each_pair(g, epsilon, n_threads, wanted, [&](const size_t i, const size_t j) {
+		const bool core_i = is_core(i), core_j = is_core(j);
+		if (core_i && core_j)
+			sets.unite((uint32_t) i, (uint32_t) j);
+		else if (core_i)
+			attach(j, i);
+		else if (core_j)
+			attach(i, j);
+	});
+
+	// The clusters are numbered in the order of the input.
+	ciede_2000_clusters result = {std::vector<int32_t>(n, -1), std::vector<uint8_t>(n, 0), 0};
+	std::vector<uint32_t> position(n);
+	for (size_t i = 0; i < n; ++i)
+		position[g.index[i]] = (uint32_t) i;
+	std::vector<int32_t> number(n, -1);
+	const auto label_of = [&](const uint32_t core) {
+		int32_t &label = number[sets.find(core)];
+		if (label < 0)
+			label = result.n_clusters++;
+		return label;
+	};
+	for (size_t i = 0; i < n; ++i) {
+		const uint32_t p = position[i];
+		if (is_core(p))
+			result.core[i] = 1, result.label[i] = label_of(p);
+		else if (anchor[p].load(std::memory_order_relaxed) != SIZE_MAX)
+			result.label[i] = label_of(position[anchor[p].load(std::memory_order_relaxed)]);
+	}
+	return result;
+}
+
+// The O(N²) algorithm, with the same conventions.
+template<typename It>
+static ciede_2000_clusters ciede_2000_dbscan_brute_force(It first, const size_t n, const double epsilon, const uint32_t min_points) {
+	std::vector<std::vector<uint32_t>> neighbors(n);
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = i + 1; j < n; ++j) {
+			const auto &c_1 = first[i], &c_2 = first[j];
+			if (ciede_2000<double>(c_1[0], c_1[1], c_1[2], c_2[0], c_2[1], c_2[2]) <= epsilon)
+				neighbors[i].push_back((uint32_t) j), neighbors[j].push_back((uint32_t) i);
+		}
+	ciede_2000_clusters result = {std::vector<int32_t>(n, -1), std::vector<uint8_t>(n, 0), 0};
+	for (size_t i = 0; i < n; ++i)
+		result.core[i] = min_points <= neighbors[i].size() + 1;
+	for (size_t i = 0; i < n; ++i)
+		if (result.core[i] && result.label[i] < 0) {
+			// A breadth-first expansion of the cluster from its first core color.
+			std::vector<uint32_t> queue = {(uint32_t) i};
+			result.label[i] = result.n_clusters;
+			for (size_t k = 0; k < queue.size(); ++k)
+				for (const uint32_t j : neighbors[queue[k]])
+					if (result.core[j] && result.label[j] < 0)
+						result.label[j] = result.n_clusters, queue.push_back(j);
+			++result.n_clusters;
+		}
+	// Then the border colors join the cluster of their core neighbor of smallest index.
+	for (size_t i = 0; i < n; ++i)
+		if (!result.core[i]) {
+			uint32_t best = UINT32_MAX;
+			for (const uint32_t j : neighbors[i])
+				if (result.core[j])
+					best = std::min(best, j);
+			if (best != UINT32_MAX)
+				result.label[i] = result.label[best];
+		}
+	return result;
+}
+
+// Two labelings are the same if a bijection maps the clusters of one to those of the other.
+static bool same_clusters(const ciede_2000_clusters &x, const ciede_2000_clusters &y) {
+	if (x.core != y.core || x.n_clusters != y.n_clusters || x.label.size() != y.label.size())
+		return false;
+	std::vector<int32_t> map(x.n_clusters, -1), reverse(y.n_clusters, -1);
+	for (size_t i = 0; i < x.label.size(); ++i) {
+		const int32_t a = x.label[i], b = y.label[i];
+		if ((a < 0) != (b < 0))
+			return false;
+		if (a < 0)
+			continue;
+		if (map[a] < 0 && reverse[b] < 0)
+			map[a] = b, reverse[b] = a;
+		if (map[a] != b || reverse[b] != a)
+			return false;
+	}
+	return true;
+}
+
+static inline uint64_t xor_random(uint64_t &s) {
+	return s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+}
+
+static inline double uniform(uint64_t &s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+template<typename F>
+static double seconds(const F &f) {
+	const auto t_1 = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t_1).count();
+}
+
+int main(int argc, char *argv[]) {
+	// Usage : ./ciede-2000-dbscan [number of colors] [ε] [min points] [seed] [output file]
+	using color = std::array<double, 3>;
+	const long parsed_n = 1 < argc ? std::strtol(argv[1], nullptr, 10) : 0;
+	const size_t n = parsed_n < 1 ? 1000000 : (size_t) parsed_n;
+	const double parsed_epsilon = 2 < argc ? std::strtod(argv[2], nullptr) : 0.0, epsilon = 0.0 < parsed_epsilon ? parsed_epsilon : 1.0;
+	const long parsed_min = 3 < argc ? std::strtol(argv[3], nullptr, 10) : 0;
+	const uint32_t min_points = parsed_min < 1 ? 8 : (uint32_t) parsed_min;
+	const uint64_t parsed_seed = std::strtoull(4 < argc ? argv[4] : "0", nullptr, 10);
+	uint64_t s = parsed_seed ? parsed_seed : (uint64_t) std::chrono::system_clock::now().time_since_epoch().count() | 1;
+	FILE *out = 5 < argc ? std::fopen(argv[5], "w") : nullptr;
+	if (5 < argc && !out) {
+		std::perror("Delta E 2000");
+		return 3;
+	}
+	// Production batches : colors scattered around a few thousand targets, and 10% of random colors.
+	std::vector<color> targets(std::max<size_t>(n / 1000, 1)), colors(n);
+	for (auto &t : targets)
+		t = {uniform(s, 5.0, 95.0), uniform(s, -100.0, 100.0), uniform(s, -100.0, 100.0)};
+	for (auto &c : colors)
+		if (xor_random(s) % 10) {
+			const color &t = targets[xor_random(s) % targets.size()];
+			const double spread = uniform(s, 0.0, 2.0 * epsilon);
+			c = {t[0] + uniform(s, -spread, spread), t[1] + uniform(s, -spread, spread), t[2] + uniform(s, -spread, spread)};
+		} else
+			c = {uniform(s, 0.0, 100.0), uniform(s, -128.0, 128.0), uniform(s, -128.0, 128.0)};
+
+	// A subset is first clustered by the O(N²) algorithm, both must give the same clusters.
+	const size_t m = std::min<size_t>(n, 4000);
+	const auto expected = ciede_2000_dbscan_brute_force(colors.begin(), m, epsilon, min_points);
+	const auto got = ciede_2000_dbscan(colors.begin(), m, epsilon, min_points);
+	const bool ok = same_clusters(got, expected);
+	std::printf("DBSCAN of %zu colors with ε = %g and %u min points : %d clusters, %s the O(N²) algorithm.\n", m, epsilon, min_points, got.n_clusters, ok ? "same as" : "DIFFERENT FROM");
+
+	ciede_2000_clusters result;
+	const double t = seconds([&] { result = ciede_2000_dbscan(colors.begin(), n, epsilon, min_points); });
+	const size_t n_core = (size_t) std::count(result.core.begin(), result.core.end(), 1);
+	const size_t n_noise = (size_t) std::count(result.label.begin(), result.label.end(), -1);
+	std::printf("DBSCAN of %zu colors : %d clusters, %zu core colors, %zu noise colors, in %.2f s.\n", n, result.n_clusters, n_core, n_noise, t);
+	if (out) {
+		std::fprintf(out, "L,a,b,cluster,core\n");
+		for (size_t i = 0; i < n; ++i)
+			std::fprintf(out, "%.17g,%.17g,%.17g,%d,%d\n", colors[i][0], colors[i][1], colors[i][2], result.label[i], result.core[i]);
+		std::fclose(out);
+	}
+	if (ok)
+		std::printf("  - PASS : The clusters are those of the O(N²) algorithm\n");
+	else
+		std::printf("  - FAIL : The clusters differ from those of the O(N²) algorithm\n");
+	return !ok;
+}
+
+// The compilation is done using GCC or CLang :
+// - g++ -std=c++17 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-dbscan ciede-2000-dbscan.cpp
+// - clang++ -std=c++17 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-dbscan ciede-2000-dbscan.cpp
@@ -0,0 +1,460 @@
+// This C++ program is released into the public domain.
+// Provided "as is", without any warranty, express or implied.
+
+#include "fuzz-prelude.cpp"
+#include "../c/libciede2000.h"
+
+/////////////////////////////////////////////////
+////////                                 ////////
+////////             CIEDE2000           ////////
+////////       Differential Fuzzing      ////////
+////////        of Every Variant         ////////
+////////                                 ////////
+/////////////////////////////////////////////////
+
+// This program feeds the same adversarial L*a*b* pairs to every ΔE2000 kernel of the repository, on all the
+// CPU cores, and reports the maximum and mean deviations for each pair of variants. The variants that share a
+// family (64-bit, 64-bit canonical, 32-bit) must agree within the larger of their tolerances, a disagreement is
+// minimized (its components are simplified as long as the disagreement persists) and saved in a CSV file.
+// The approximations (accuracy tiers, 32-bit computations) aren't compared within a band around the hue
+// discontinuity, where they legitimately pick the other side. The 32-bit kernels must also agree with the
+// 64-bit ones outside a wider band, the other pairs of different families are only measured.
+
+// The "fuzz-prelude.cpp" file is generated from the sources of the repository (see fuzzer.yml) :
+// - ciede_2000_c_double and ciede_2000_c_float from ciede-2000.c and ciede-2000-single-precision.c
+// - ciede_2000_cpp from ciede-2000.cpp and ciede_2000_constexpr from ciede-2000-constexpr.cpp
+// - ciede_2000_functional, ciede_2000_standard, the balanced tier, ciede_2000_both and ciede_2000_components
+//   from the C99 driver
+// - ciede_2000_batch from compare-hex-colors-batch.c
+// - ciede_2000_lanes, ciede_2000_compact_batch and ciede_2000_tiers from ciede-2000-simd.cpp,
+//   ciede-2000-compact.cpp and ciede-2000-accuracy.cpp
+// The ciede2000_batch and ciede2000f_batch functions come from libciede2000, whose code path is the one of the
+// CIEDE2000_PATH environment variable, such as "avx2" or "sse2 float".
+// Project : https://github.com/michel-leonard/ciede2000-color-matching
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr int BATCH = 4096;
+constexpr int MAX_CASES_PER_PAIR = 8;
+
+// The L*a*b* pairs of a batch, in arrays (structure of arrays).
+struct batch {
+	double l_1[BATCH], a_1[BATCH], b_1[BATCH], l_2[BATCH], a_2[BATCH], b_2[BATCH];
+};
+
+enum kernel_family { DOUBLE, DOUBLE_CANONICAL, FLOAT };
+
+// The tolerance against the variants of the family, and the radius (in radian) of the band around the hue
+// discontinuity where the variant isn't compared.
+struct variant {
+	const char *name;
+	kernel_family family;
+	void (*run)(const batch &in, int n, double *out);
+	double tolerance;
+	double band;
+};
+
+// The exact 64-bit kernels are compared like the C99 driver does, the exact 32-bit ones like the identity workflow.
+constexpr double EXACT_64 = 1E-10, EXACT_32 = 0.0, EXACT_BAND = 1E-12;
+
+// The approximations are compared outside 1E-4 radian of the hue discontinuity, as ciede-2000-accuracy.cpp does.
+constexpr double APPROXIMATION_BAND = 1E-4;
+
+// The 32-bit kernels against the 64-bit ones, within the precision of a float ΔE2000 of up to about 200.
+constexpr double FLOAT_VS_DOUBLE = 1E-3;
+
+template<double (*F)(double, double, double, double, double, double)>
+static void scalar_64(const batch &in, const int n, double *out) {
+	for (int i = 0; i < n; ++i)
+		out[i] = F(in.l_1[i], in.a_1[i], in.b_1[i], in.l_2[i], in.a_2[i], in.b_2[i]);
+}
+
+template<float (*F)(float, float, float, float, float, float)>
+static void scalar_32(const batch &in, const int n, double *out) {
+	for (int i = 0; i < n; ++i)
+		out[i] = F((float) in.l_1[i], (float) in.a_1[i], (float) in.b_1[i], (float) in.l_2[i], (float) in.a_2[i], (float) in.b_2[i]);
+}
+
+template<int CANONICAL>
+static void driver_functional(const batch &in, const int n, double *out) {
+	for (int i = 0; i < n; ++i)
+		out[i] = ciede_2000_functional(in.l_1[i], in.a_1[i], in.b_1[i], in.l_2[i], in.a_2[i], in.b_2[i], CANONICAL);
+}
+
+template<int CANONICAL>
+static void driver_standard(const batch &in, const int n, double *out) {
+	for (int i = 0; i < n; ++i)
+		out[i] = ciede_2000_standard(in.l_1[i], in.a_1[i], in.b_1[i], in.l_2[i], in.a_2[i], in.b_2[i], CANONICAL);
+}
+
+template<bool CANONICAL>
+static void constexpr_64(const batch &in, const int n, double *out) {
+	for (int i = 0; i < n; ++i)
+		out[i] = ciede_2000_constexpr(in.l_1[i], in.a_1[i], in.b_1[i], in.l_2[i], in.a_2[i], in.b_2[i], 1.0, 1.0, 1.0, CANONICAL);
+}
+
+static void hex_batch(const batch &in, const int n, double *out) {
+	ciede_2000_batch(n, in.l_1, in.a_1, in.b_1, in.l_2, in.a_2, in.b_2, out);
+}
+
+// The 32-bit batch kernels read float arrays.
+template<void (*F)(size_t, const float *, const float *, const float *, const float *, const float *, const float *, float *)>
+static void batch_32(const batch &in, const int n, double *out) {
+	static thread_local float c[7][BATCH];
+	for (int i = 0; i < n; ++i)
+		c[0][i] = (float) in.l_1[i], c[1][i] = (float) in.a_1[i], c[2][i] = (float) in.b_1[i], c[3][i] = (float) in.l_2[i], c[4][i] = (float) in.a_2[i], c[5][i] = (float) in.b_2[i];
+	F((size_t) n, c[0], c[1], c[2], c[3], c[4], c[5], c[6]);
+	for (int i = 0; i < n; ++i)
+		out[i] = c[6][i];
+}
+
+template<void (*F)(size_t, const double *, const double *, const double *, const double *, const double *, const double *, double *)>
+static void batch_64(const batch &in, const int n, double *out) {
+	F((size_t) n, in.l_1, in.a_1, in.b_1, in.l_2, in.a_2, in.b_2, out);
+}
+
+// The compact kernel on uncompressed stores, its 16-bit formats only adding the rounding of the values.
+template<typename T>
+static void compact_native(const batch &in, const int n, double *out) {
+	lab_store<lab_native<T>> store_1((size_t) n), store_2((size_t) n);
+	T delta_e[BATCH];
+	for (int i = 0; i < n; ++i) {
+		store_1.set((size_t) i, in.l_1[i], in.a_1[i], in.b_1[i]);
+		store_2.set((size_t) i, in.l_2[i], in.a_2[i], in.b_2[i]);
+	}
+	ciede_2000_compact_batch((size_t) n, store_1, store_2, delta_e);
+	for (int i = 0; i < n; ++i)
+		out[i] = delta_e[i];
+}
+
+template<int TIER>
+static void driver_tier(const batch &in, const int n, double *out) {
+	for (int i = 0; i < n; ++i)
+		out[i] = ciede_2000_accuracy(in.l_1[i], in.a_1[i], in.b_1[i], in.l_2[i], in.a_2[i], in.b_2[i], 0, tiers + TIER);
+}
+
+template<int CANONICAL>
+static void driver_both(const batch &in, const int n, double *out) {
+	for (int i = 0; i < n; ++i) {
+		double delta_e[2];
+		ciede_2000_both(in.l_1[i], in.a_1[i], in.b_1[i], in.l_2[i], in.a_2[i], in.b_2[i], delta_e);
+		out[i] = delta_e[CANONICAL];
+	}
+}
+
+template<int CANONICAL>
+static void driver_components(const batch &in, const int n, double *out) {
+	for (int i = 0; i < n; ++i) {
+		double terms[N_COMPONENTS];
+		ciede_2000_components(in.l_1[i], in.a_1[i], in.b_1[i], in.l_2[i], in.a_2[i], in.b_2[i], CANONICAL, terms);
+		out[i] = terms[N_COMPONENTS - 1];
+	}
+}
+
+static bool library_narrow() {
+	// The configuration is such as "avx2 double 256", "float" meaning that ciede2000_batch computes in 32-bit.
+	return std::strstr(ciede2000_config(), " float ") != nullptr;
+}
+
+using tier_fast = ciede_2000_accuracy_detail::tier<accuracy::fast>;
+using tier_balanced = ciede_2000_accuracy_detail::tier<accuracy::balanced>;
+
+// New kernels of the repository are added here, with the family they must agree with, their tolerance and band.
+static const variant variants[] = {
+	{"c-double", DOUBLE, scalar_64<ciede_2000_c_double>, EXACT_64, EXACT_BAND},
+	{"cpp-double", DOUBLE, scalar_64<ciede_2000_cpp<double>>, EXACT_64, EXACT_BAND},
+	{"constexpr", DOUBLE, constexpr_64<false>, EXACT_64, EXACT_BAND},
+	{"driver-standard", DOUBLE, driver_standard<0>, EXACT_64, EXACT_BAND},
+	{"driver-functional", DOUBLE, driver_functional<0>, EXACT_64, EXACT_BAND},
+	{"driver-both", DOUBLE, driver_both<0>, EXACT_64, EXACT_BAND},
+	{"driver-components", DOUBLE, driver_components<0>, EXACT_64, EXACT_BAND},
+	{"hex-batch", DOUBLE, hex_batch, EXACT_64, EXACT_BAND},
+	{"simd-double", DOUBLE, batch_64<ciede_2000_lanes<4, double>>, EXACT_64, EXACT_BAND},
+	{"compact-double", DOUBLE, compact_native<double>, EXACT_64, EXACT_BAND},
+	{"lib-batch", DOUBLE, batch_64<ciede2000_batch>, library_narrow() ? FLOAT_VS_DOUBLE : EXACT_64, library_narrow() ? APPROXIMATION_BAND : EXACT_BAND},
+	{"driver-balanced", DOUBLE, driver_tier<0>, tiers[0].contract, APPROXIMATION_BAND},
+	{"tier-balanced", DOUBLE, scalar_64<ciede_2000_tiers<accuracy::balanced>>, tier_balanced::contract, APPROXIMATION_BAND},
+	{"tier-fast", DOUBLE, scalar_64<ciede_2000_tiers<accuracy::fast>>, tier_fast::contract, APPROXIMATION_BAND},
+	{"constexpr-canonical", DOUBLE_CANONICAL, constexpr_64<true>, EXACT_64, EXACT_BAND},
+	{"standard-canonical", DOUBLE_CANONICAL, driver_standard<1>, EXACT_64, EXACT_BAND},
+	{"functional-canonical", DOUBLE_CANONICAL, driver_functional<1>, EXACT_64, EXACT_BAND},
+	{"both-canonical", DOUBLE_CANONICAL, driver_both<1>, EXACT_64, EXACT_BAND},
+	{"components-canonical", DOUBLE_CANONICAL, driver_components<1>, EXACT_64, EXACT_BAND},
+	{"c-float", FLOAT, scalar_32<ciede_2000_c_float>, EXACT_32, EXACT_BAND},
+	{"cpp-float", FLOAT, scalar_32<ciede_2000_cpp<float>>, EXACT_32, EXACT_BAND},
+	{"simd-float", FLOAT, batch_32<ciede_2000_lanes<8, float>>, EXACT_32, EXACT_BAND},
+	{"compact-float", FLOAT, compact_native<float>, EXACT_32, EXACT_BAND},
+	{"lib-float-batch", FLOAT, batch_32<ciede2000f_batch>, FLOAT_VS_DOUBLE, APPROXIMATION_BAND},
+};
+
+constexpr int N_VARIANTS = sizeof(variants) / sizeof(*variants);
+constexpr int N_PAIRS = N_VARIANTS * (N_VARIANTS - 1) / 2;
+
+// The tolerance of a pair of variants (NaN when the pair is only measured), and its band around the hue
+// discontinuity. The 32-bit kernels are held to the 64-bit ones of the same convention outside a wider band.
+struct limits {
+	double tolerance, band;
+};
+
+static limits pair_limits(const variant &v_1, const variant &v_2) {
+	const limits same = {std::max(v_1.tolerance, v_2.tolerance), std::max(v_1.band, v_2.band)};
+	if (v_1.family == v_2.family)
+		return same;
+	if ((v_1.family == FLOAT && v_2.family == DOUBLE) || (v_1.family == DOUBLE && v_2.family == FLOAT))
+		return {std::max(same.tolerance, FLOAT_VS_DOUBLE), std::max(same.band, APPROXIMATION_BAND)};
+	return {NAN, same.band};
+}
+
+static double hue_gap(const double *c) {
+	// ΔE2000 jumps when the hue angles are π apart, and the canonical mean jumps when it wraps on π, so a variant
+	// rounding G differently by one ulp can legitimately land on the other side. The distance of the hue
+	// difference to π is returned, or 0 when the canonical mean wraps within 4E-15 of π (the 64-bit variants).
+	const long double pi = 3.141592653589793238462643383279502884L;
+	const long double c_1 = std::hypot((long double) c[1], (long double) c[2]), c_2 = std::hypot((long double) c[4], (long double) c[5]);
+	const long double c_7 = std::pow(0.5L * (c_1 + c_2), 7.0L), g = 1.0L + 0.5L * (1.0L - std::sqrt(c_7 / (c_7 + 6103515625.0L)));
+	long double h_1 = std::atan2((long double) c[2], c[1] * g), h_2 = std::atan2((long double) c[5], c[4] * g);
+	h_1 += (h_1 < 0.0L) * 2.0L * pi, h_2 += (h_2 < 0.0L) * 2.0L * pi;
+	const long double delta_h = std::fabs(h_2 - h_1);
+	return pi < delta_h && std::fabs(0.5L * (h_1 + h_2) - pi) < 4E-15L ? 0.0 : (double) std::fabs(delta_h - pi);
+}
+
+static inline uint64_t xor_random(uint64_t &s) {
+	// A shift-register generator has a reproducible behavior across platforms.
+	return s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+}
+
+static inline double uniform(uint64_t &s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static inline double rounded(uint64_t &s, const double value) {
+	// Like the datasets of the repository, numbers often have 0, 1 or 2 decimals.
+	switch (xor_random(s) & 3) {
+		case 0: return std::round(value);
+		case 1: return std::round(value * 10.0) / 10.0;
+		case 2: return std::round(value * 100.0) / 100.0;
+		default: return value;
+	}
+}
+
+static inline double perturbation(uint64_t &s) {
+	// The magnitudes used by perturb() in the C99 driver.
+	static const double magnitudes[8] = {1e-12, 1.7e-11, 2.9e-10, 4.9e-9, 8.4e-8, 1.4e-6, 2.4e-5, 4.1e-4};
+	const uint64_t x = xor_random(s);
+	return (x & 1 ? -1.0 : 1.0) * magnitudes[(x >> 1) & 7] * (double) (1 + ((x >> 4) & 15));
+}
+
+static void adversarial_pair(uint64_t &s, double *c) {
+	const uint64_t mode = xor_random(s) % 6;
+	c[0] = rounded(s, uniform(s, 0.0, 100.0)), c[3] = rounded(s, uniform(s, 0.0, 100.0));
+	if (mode == 0) {
+		// Ordinary colors, with the rounding of the datasets.
+		for (const int i : {1, 2, 4, 5})
+			c[i] = rounded(s, uniform(s, -128.0, 128.0));
+	} else if (mode == 1 || mode == 2) {
+		// Hue angles about π apart (mode 1), or on both sides of 0 with a mean close to π (mode 2).
+		const double c_1 = uniform(s, 0.0, 128.0), c_2 = uniform(s, 0.0, 128.0), h_1 = uniform(s, 0.0, 2.0 * M_PI);
+		const double epsilon = (xor_random(s) & 1 ? -1.0 : 1.0) * std::pow(10.0, uniform(s, -16.0, -1.0)) * (double) (xor_random(s) & 7 ? 1 : 0);
+		const double h_2 = mode == 1 ? h_1 + M_PI + epsilon : -h_1 * 0.01 + epsilon;
+		c[1] = c_1 * std::cos(mode == 1 ? h_1 : h_1 * 0.01), c[2] = c_1 * std::sin(mode == 1 ? h_1 : h_1 * 0.01);
+		c[4] = c_2 * std::cos(h_2), c[5] = c_2 * std::sin(h_2);
+	} else if (mode == 3) {
+		// Achromatic colors, with signed zeros and tiny chromas.
+		for (const int i : {1, 2, 4, 5}) {
+			const uint64_t x = xor_random(s);
+			c[i] = x & 1 ? (x & 2 ? -0.0 : 0.0) : x & 4 ? std::pow(10.0, uniform(s, -300.0, -3.0)) * (x & 8 ? -1.0 : 1.0) : rounded(s, uniform(s, -128.0, 128.0));
+		}
+	} else if (mode == 4) {
+		// Nearly identical colors, the second one being perturbed like in the C99 driver.
+		c[1] = rounded(s, uniform(s, -128.0, 128.0)), c[2] = rounded(s, uniform(s, -128.0, 128.0));
+		for (int i = 0; i < 3; ++i)
+			c[i + 3] = c[i] + (xor_random(s) & 1 ? perturbation(s) : 0.0);
+	} else {
+		// Chromas close to 25 (where C⁷ meets 25⁷), blue hues (rotation term) and lightness close to 50.
+		const double c_1 = 25.0 + perturbation(s) * 1E3, c_2 = 25.0 + perturbation(s) * 1E3;
+		const double h_1 = 275.0 * M_PI / 180.0 + uniform(s, -0.5, 0.5), h_2 = h_1 + uniform(s, -0.2, 0.2);
+		c[0] = 50.0 + perturbation(s), c[3] = 50.0 - perturbation(s);
+		c[1] = c_1 * std::cos(h_1), c[2] = c_1 * std::sin(h_1), c[4] = c_2 * std::cos(h_2), c[5] = c_2 * std::sin(h_2);
+	}
+	if (xor_random(s) & 1)
+		for (int i = 0; i < 3; ++i)
+			std::swap(c[i], c[i + 3]);
+}
+
+struct pair_stats {
+	double max = 0.0, sum = 0.0;
+	uint64_t n = 0, n_failures = 0;
+	std::vector<std::array<double, 6>> cases;
+};
+
+static double disagreement(const double x, const double y) {
+	// A NaN produced by a single variant is an infinite deviation.
+	const double d = std::fabs(x - y);
+	return std::isnan(d) ? std::isnan(x) != std::isnan(y) ? INFINITY : 0.0 : d;
+}
+
+static double deviation(const int i, const int j, const double *c) {
+	// Runs two variants on a single pair, used by the minimization.
+	batch in;
+	double out_1, out_2;
+	in.l_1[0] = c[0], in.a_1[0] = c[1], in.b_1[0] = c[2], in.l_2[0] = c[3], in.a_2[0] = c[4], in.b_2[0] = c[5];
+	variants[i].run(in, 1, &out_1);
+	variants[j].run(in, 1, &out_2);
+	return disagreement(out_1, out_2);
+}
+
+static std::array<double, 6> minimize(const int i, const int j, std::array<double, 6> c) {
+	// Greedily replaces each component by a simpler number (zero, then fewer decimals) while the disagreement remains.
+	const limits limit = pair_limits(variants[i], variants[j]);
+	for (bool changed = true; changed;) {
+		changed = false;
+		for (int k = 0; k < 6; ++k)
+			for (int digits = -1; digits <= 6; ++digits) {
+				const double scale = std::pow(10.0, digits), simpler = digits < 0 ? 0.0 : std::round(c[k] * scale) / scale;
+				if (simpler == c[k])
+					break;
+				const double previous = c[k];
+				c[k] = simpler;
+				if (limit.tolerance < deviation(i, j, c.data()) && limit.band <= hue_gap(c.data())) {
+					changed = true;
+					break;
+				}
+				c[k] = previous;
+			}
+	}
+	return c;
+}
+
+static void fuzz(const uint64_t seed, const uint64_t n_inputs, std::vector<pair_stats> &stats, uint64_t &n_edges) {
+	static thread_local batch in;
+	static thread_local double out[N_VARIANTS][BATCH];
+	static thread_local double gap[BATCH];
+	uint64_t s = seed;
+	stats.assign(N_PAIRS, pair_stats());
+	n_edges = 0;
+	for (uint64_t done = 0; done < n_inputs; done += BATCH) {
+		const int n = (int) std::min<uint64_t>(BATCH, n_inputs - done);
+		for (int k = 0; k < n; ++k) {
+			double c[6];
+			adversarial_pair(s, c);
+			in.l_1[k] = c[0], in.a_1[k] = c[1], in.b_1[k] = c[2], in.l_2[k] = c[3], in.a_2[k] = c[4], in.b_2[k] = c[5];
+			n_edges += (gap[k] = hue_gap(c)) < EXACT_BAND;
+		}
+		for (int v = 0; v < N_VARIANTS; ++v)
+			variants[v].run(in, n, out[v]);
+		for (int i = 0, p = 0; i < N_VARIANTS; ++i)
+			for (int j = i + 1; j < N_VARIANTS; ++j, ++p) {
+				pair_stats &st = stats[p];
+				const limits limit = pair_limits(variants[i], variants[j]);
+				for (int k = 0; k < n; ++k) {
+					if (gap[k] < limit.band)
+						continue;
+					const double e = disagreement(out[i][k], out[j][k]);
+					st.sum += std::isinf(e) ? 0.0 : e;
+					st.max = std::max(st.max, e);
+					++st.n;
+					if (limit.tolerance < e) {
+						++st.n_failures;
+						if (st.cases.size() < MAX_CASES_PER_PAIR)
+							st.cases.push_back({in.l_1[k], in.a_1[k], in.b_1[k], in.l_2[k], in.a_2[k], in.b_2[k]});
+					}
+				}
+			}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	// Usage : ./ciede-2000-fuzzer [number of inputs] [seed] [threads]
+	const double parsed_n_inputs = 1 < argc ? std::strtod(argv[1], nullptr) : 0.0;
+	const uint64_t n_inputs = parsed_n_inputs < 1E6 ? 1000000 : (uint64_t) parsed_n_inputs;
+	const uint64_t parsed_seed = std::strtoull(2 < argc ? argv[2] : "0", nullptr, 10);
+	const uint64_t seed = parsed_seed ? parsed_seed : (uint64_t) std::chrono::system_clock::now().time_since_epoch().count();
+	const long parsed_threads = 3 < argc ? std::strtol(argv[3], nullptr, 10) : 0;
+	const int n_threads = 0 < parsed_threads ? (int) parsed_threads : std::max(1, (int) std::thread::hardware_concurrency());
+
+	std::fprintf(stdout, "====== Delta E 2000 Differential Fuzzing ======\n");
+	std::fprintf(stdout, "Variants      : %d (%d pairs)\n", N_VARIANTS, N_PAIRS);
+	std::fprintf(stdout, "Inputs        : %" PRIu64 " adversarial L*a*b* pairs\n", n_inputs);
+	std::fprintf(stdout, "Seed          : %" PRIu64 "\n", seed);
+	std::fprintf(stdout, "Threads       : %d\n", n_threads);
+	std::fprintf(stdout, "libciede2000  : %s\n\n", ciede2000_config());
+	std::fflush(stdout);
+
+	const auto t_1 = std::chrono::steady_clock::now();
+	std::vector<std::vector<pair_stats>> per_thread(n_threads);
+	std::vector<uint64_t> edges(n_threads);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < n_threads; ++t) {
+		// Each thread has its own stream, derived from the seed and its index.
+		const uint64_t n = n_inputs / n_threads + (uint64_t) (t < (int) (n_inputs % n_threads));
+		uint64_t stream = seed ^ (0x9E3779B97F4A7C15ULL * (uint64_t) (t + 1));
+		stream += (stream == 0);
+		threads.emplace_back(fuzz, stream, n, std::ref(per_thread[t]), std::ref(edges[t]));
+	}
+	for (auto &thread: threads)
+		thread.join();
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_1).count();
+
+	std::vector<pair_stats> stats(N_PAIRS);
+	for (const auto &partial: per_thread)
+		for (int p = 0; p < N_PAIRS; ++p) {
+			stats[p].max = std::max(stats[p].max, partial[p].max);
+			stats[p].sum += partial[p].sum;
+			stats[p].n += partial[p].n;
+			stats[p].n_failures += partial[p].n_failures;
+			for (const auto &c: partial[p].cases)
+				if (stats[p].cases.size() < MAX_CASES_PER_PAIR)
+					stats[p].cases.push_back(c);
+		}
+
+	uint64_t n_failures = 0, n_edges = 0;
+	for (const uint64_t n: edges)
+		n_edges += n;
+	// A minimized case often explains the failures of several pairs, it is written once.
+	std::set<std::array<double, 6>> written;
+	std::FILE *fp = nullptr;
+	std::fprintf(stdout, "%-21s %-21s %-11s %-11s %s\n", "Variant 1", "Variant 2", "Max dev.", "Mean dev.", "Failures");
+	for (int i = 0, p = 0; i < N_VARIANTS; ++i)
+		for (int j = i + 1; j < N_VARIANTS; ++j, ++p) {
+			const pair_stats &st = stats[p];
+			const bool gated = !std::isnan(pair_limits(variants[i], variants[j]).tolerance);
+			std::fprintf(stdout, "%-21s %-21s %-11.2e %-11.2e %s\n", variants[i].name, variants[j].name, st.max, st.sum / (double) std::max<uint64_t>(1, st.n), gated ? std::to_string(st.n_failures).c_str() : "-");
+			n_failures += st.n_failures;
+			for (const auto &c: st.cases) {
+				if (fp == nullptr && (fp = std::fopen("fuzzer-failures.csv", "wb")))
+					std::fprintf(fp, "L1,a1,b1,L2,a2,b2,variant_1,variant_2,deviation\n");
+				const auto m = minimize(i, j, c);
+				if (fp && written.insert(m).second)
+					std::fprintf(fp, "%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%s,%s,%.3g\n", m[0], m[1], m[2], m[3], m[4], m[5], variants[i].name, variants[j].name, deviation(i, j, m.data()));
+			}
+		}
+	if (fp)
+		std::fclose(fp);
+
+	std::fprintf(stdout, "\nDuration      : %.2f s\n", seconds);
+	std::fprintf(stdout, "Edge cases    : %" PRIu64 " inputs on a hue discontinuity, where the variants may differ\n", n_edges);
+	std::fprintf(stdout, "Throughput    : %.2f billion comparisons per hour\n", (double) n_inputs * N_PAIRS / seconds * 3600.0 / 1E9);
+	if (n_failures)
+		std::fprintf(stdout, "\n  - FAIL : %" PRIu64 " disagreements within a family, minimized cases in fuzzer-failures.csv\n", n_failures);
+	else
+		std::fprintf(stdout, "\n  - PASS : The variants of each family agree on every adversarial input\n");
+	return n_failures != 0;
+}
+
+// Generation of the prelude, then compilation, from the root of the repository :
+// - see the "Initialize" step of .github/workflows/fuzzer.yml to generate tests/cpp/fuzz-prelude.cpp
+// - see the "Compile" step to build libciede2000.so, the fuzzer being linked to it :
+//   g++ -std=c++17 -Wall -Wextra -O2 -pthread -o ciede-2000-fuzzer tests/cpp/ciede-2000-fuzzer.cpp -L. -lciede2000
+// Finally, the execution is done using LD_LIBRARY_PATH=. ./ciede-2000-fuzzer, with CIEDE2000_PATH to select the path.
@@ -0,0 +1,350 @@
+// This function written in C++ is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#include <cmath>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327950288419716939937511
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+template<typename T>
+static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2) {
+	// Working in C++ with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+	// Application of the chroma correction factor.
+	const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	T h_1 = std::atan2(b_1, a_1 * n);
+	T h_2 = std::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+	n = std::fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
+		n = T(M_PI);
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	T h_m = (h_1 + h_2) * T(0.5);
+	T h_d = (h_2 - h_1) * T(0.5);
+	h_d += (T(M_PI) < n) * T(M_PI);
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (T(M_PI) < n) * T(M_PI);
+	// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+	const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+	n = (c_1 + c_2) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0)))
+			* std::sin(T(M_PI) / T(3.0) * std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI))));
+	n = (l_1 + l_2) * T(0.5);
+	n = (n - T(50.0)) * (n - T(50.0));
+	// Lightness.
+	const T l = (l_2 - l_1) / (k_l * (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+				- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+	n = c_1 + c_2;
+	// Hue.
+	const T h = T(2.0) * std::sqrt(c_1 * c_2) * std::sin(h_d) / (k_h * (T(1.0) + T(3.0) / T(400.0) * n * t));
+	// Chroma.
+	const T c = (c_2 - c_1) / (k_c * (T(1.0) + T(9.0) / T(400.0) * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 96.5   a1 = 47.8   b1 = 4.6
+// L2 = 96.8   a2 = 53.2   b2 = -4.1
+// CIE ΔE00 = 4.6680978034 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 4.6680847226 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.3e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////        Analytic Gradient        ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// For optimizers minimizing sums of ΔE2000 (color correction, gamut mapping, palette fitting...), this program
+// computes the ΔE2000 together with its 6 partial derivatives with respect to the L*a*b* inputs. A forward pass
+// identical to the function above keeps its intermediates (c_1, c_2, h_m, t, r_t...), then a backward pass
+// propagates the derivative of ΔE2000 through them, in reverse order, like an automatic differentiation would.
+// This replaces the 13 calls of a central finite difference by the cost of less than 2 calls, without noise.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Returns the ΔE2000 between two L*a*b* colors, and stores in "grad" its partial derivatives with respect to
+// l_1, a_1, b_1, l_2, a_2 and b_2, in this order. Where ΔE2000 isn't differentiable (identical colors, colors
+// having no chroma), the partials that would be infinite or undefined are set to 0, which is a valid descent
+// direction for optimizers. Where it jumps (hues π apart, a hue crossing 0), the derivatives are one-sided.
+template<typename T>
+static T ciede_2000_grad(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2, T *grad) {
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	// Forward pass, computed like ciede_2000 (the results are identical) while keeping the intermediates.
+	const T c_1_orig = std::sqrt(a_1 * a_1 + b_1 * b_1);
+	const T c_2_orig = std::sqrt(a_2 * a_2 + b_2 * b_2);
+	const T c_mean = (c_1_orig + c_2_orig) * T(0.5);
+	const T c_mean_7 = c_mean * c_mean * c_mean * c_mean * c_mean * c_mean * c_mean;
+	const T g_sqrt = std::sqrt(c_mean_7 / (c_mean_7 + T(6103515625.0)));
+	const T g = T(1.0) + T(0.5) * (T(1.0) - g_sqrt);
+	const T a_1_prime = a_1 * g;
+	const T a_2_prime = a_2 * g;
+	const T c_1 = std::sqrt(a_1 * a_1 * g * g + b_1 * b_1);
+	const T c_2 = std::sqrt(a_2 * a_2 * g * g + b_2 * b_2);
+	T h_1 = std::atan2(b_1, a_1_prime);
+	T h_2 = std::atan2(b_2, a_2_prime);
+	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+	T n = std::fabs(h_2 - h_1);
+	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
+		n = T(M_PI);
+	T h_m = (h_1 + h_2) * T(0.5);
+	T h_d = (h_2 - h_1) * T(0.5);
+	h_d += (T(M_PI) < n) * T(M_PI);
+	h_m += (T(M_PI) < n) * T(M_PI);
+	// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+	const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+	const T c_bar = (c_1 + c_2) * T(0.5);
+	const T c_bar_7 = c_bar * c_bar * c_bar * c_bar * c_bar * c_bar * c_bar;
+	const T r_c = std::sqrt(c_bar_7 / (c_bar_7 + T(6103515625.0)));
+	const T e = std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI)));
+	const T sin_e = std::sin(T(M_PI) / T(3.0) * e);
+	const T r_t = T(-2.0) * r_c * sin_e;
+	const T l_mean = (l_1 + l_2) * T(0.5);
+	const T u = (l_mean - T(50.0)) * (l_mean - T(50.0));
+	const T u_sqrt = std::sqrt(T(20.0) + u);
+	const T s_l = k_l * (T(1.0) + T(3.0) / T(200.0) * u / u_sqrt);
+	const T l = (l_2 - l_1) / s_l;
+	const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+				- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+	const T c_sum = c_1 + c_2;
+	const T c_geo = std::sqrt(c_1 * c_2);
+	const T sin_h_d = std::sin(h_d);
+	const T s_h = k_h * (T(1.0) + T(3.0) / T(400.0) * c_sum * t);
+	const T h = T(2.0) * c_geo * sin_h_d / s_h;
+	const T s_c = k_c * (T(1.0) + T(9.0) / T(400.0) * c_sum);
+	const T c = (c_2 - c_1) / s_c;
+	const T delta_e = std::sqrt(l * l + h * h + c * c + c * h * r_t);
+	if (delta_e == T(0.0)) {
+		std::fill(grad, grad + 6, T(0.0));
+		return delta_e;
+	}
+
+	// Backward pass, each "d_x" being the derivative of ΔE2000 with respect to the intermediate "x".
+	const T d_sum = T(0.5) / delta_e;
+	const T d_l = d_sum * T(2.0) * l;
+	const T d_h = d_sum * (T(2.0) * h + c * r_t);
+	const T d_c = d_sum * (T(2.0) * c + h * r_t);
+	const T d_r_t = d_sum * c * h;
+	// Lightness.
+	const T d_s_l = -d_l * l / s_l;
+	const T d_u = d_s_l * k_l * T(3.0) / T(200.0) * (T(40.0) + u) / (T(2.0) * (T(20.0) + u) * u_sqrt);
+	const T d_l_mean = d_u * T(2.0) * (l_mean - T(50.0));
+	grad[0] = -d_l / s_l + d_l_mean * T(0.5);
+	grad[3] = d_l / s_l + d_l_mean * T(0.5);
+	// Chroma and hue, towards the corrected chromas and the hue angles.
+	const T d_s_c = -d_c * c / s_c;
+	const T d_s_h = -d_h * h / s_h;
+	const T d_c_sum = d_s_c * k_c * T(9.0) / T(400.0) + d_s_h * k_h * T(3.0) / T(400.0) * t;
+	const T d_t = d_s_h * k_h * T(3.0) / T(400.0) * c_sum;
+	const T d_c_geo = d_h * T(2.0) * sin_h_d / s_h;
+	const T d_h_d = d_h * T(2.0) * c_geo * std::cos(h_d) / s_h;
+	// The hue rotation term.
+	const T d_r_c = d_r_t * T(-2.0) * sin_e;
+	const T d_e = d_r_t * T(-2.0) * r_c * std::cos(T(M_PI) / T(3.0) * e) * T(M_PI) / T(3.0);
+	const T d_p = d_e * e * T(2.0) * p / (T(-25.0) * T(M_PI) * T(M_PI));
+	const T d_c_bar = c_bar == T(0.0) ? T(0.0) : d_r_c * r_c * T(3.5) * T(6103515625.0) / (c_bar * (c_bar_7 + T(6103515625.0)));
+	const T d_h_m = d_p * T(36.0) + d_t * (
+				T(12.0) / T(25.0) * std::cos(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(24.0) / T(25.0) * std::cos(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::cos(h_m + T(M_PI) / T(3.0))
+				- T(4.0) / T(5.0) * std::cos(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0)));
+	T d_c_1 = -d_c / s_c + d_c_sum + d_c_bar * T(0.5);
+	T d_c_2 = d_c / s_c + d_c_sum + d_c_bar * T(0.5);
+	if (c_geo != T(0.0))
+		d_c_1 += d_c_geo * c_2 / (T(2.0) * c_geo), d_c_2 += d_c_geo * c_1 / (T(2.0) * c_geo);
+	const T d_h_1 = (d_h_m - d_h_d) * T(0.5);
+	const T d_h_2 = (d_h_m + d_h_d) * T(0.5);
+	// Through the hue angles and the corrected chromas, towards the corrected a and the b components.
+	T d_a_1_prime = T(0.0), d_a_2_prime = T(0.0);
+	grad[2] = grad[5] = T(0.0);
+	if (c_1 != T(0.0)) {
+		d_a_1_prime = (d_c_1 * a_1_prime - d_h_1 * b_1 / c_1) / c_1;
+		grad[2] = (d_c_1 * b_1 + d_h_1 * a_1_prime / c_1) / c_1;
+	}
+	if (c_2 != T(0.0)) {
+		d_a_2_prime = (d_c_2 * a_2_prime - d_h_2 * b_2 / c_2) / c_2;
+		grad[5] = (d_c_2 * b_2 + d_h_2 * a_2_prime / c_2) / c_2;
+	}
+	// Finally, the G factor depends on the mean of the original chromas.
+	const T d_g = d_a_1_prime * a_1 + d_a_2_prime * a_2;
+	const T d_c_mean = c_mean == T(0.0) ? T(0.0) : d_g * T(-0.5) * g_sqrt * T(3.5) * T(6103515625.0) / (c_mean * (c_mean_7 + T(6103515625.0)));
+	grad[1] = d_a_1_prime * g;
+	grad[4] = d_a_2_prime * g;
+	if (c_1_orig != T(0.0))
+		grad[1] += d_c_mean * T(0.5) * a_1 / c_1_orig, grad[2] += d_c_mean * T(0.5) * b_1 / c_1_orig;
+	if (c_2_orig != T(0.0))
+		grad[4] += d_c_mean * T(0.5) * a_2 / c_2_orig, grad[5] += d_c_mean * T(0.5) * b_2 / c_2_orig;
+	return delta_e;
+}
+
+// The batch form, in structure of arrays : for each "i", delta_e[i] receives the ΔE2000 between the colors
+// (l_1[i], a_1[i], b_1[i]) and (l_2[i], a_2[i], b_2[i]), and grad[k][i] the partial derivative with respect
+// to the k-th input, in the order l_1, a_1, b_1, l_2, a_2, b_2.
+template<typename T>
+static void ciede_2000_grad(const int len, const T *l_1, const T *a_1, const T *b_1, const T *l_2, const T *a_2, const T *b_2, T *delta_e, T *const grad[6]) {
+	for (int i = 0; i < len; ++i) {
+		T partials[6];
+		delta_e[i] = ciede_2000_grad(l_1[i], a_1[i], b_1[i], l_2[i], a_2[i], b_2[i], partials);
+		for (int k = 0; k < 6; ++k)
+			grad[k][i] = partials[k];
+	}
+}
+
+static inline uint64_t xor_random(uint64_t &s) {
+	return s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+}
+
+static inline double uniform(uint64_t &s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Central finite differences in extended precision, refined by a Richardson extrapolation (error in step⁴).
+static long double finite_difference(const double *color, const int k) {
+	long double x[6];
+	const auto f = [&](const long double step) {
+		std::copy(color, color + 6, x);
+		x[k] += step;
+		const long double hi = ciede_2000<long double>(x[0], x[1], x[2], x[3], x[4], x[5]);
+		x[k] = color[k] - step;
+		const long double lo = ciede_2000<long double>(x[0], x[1], x[2], x[3], x[4], x[5]);
+		return (hi - lo) / (2.0L * step);
+	};
+	const long double step = 1E-4L;
+	return (4.0L * f(step * 0.5L) - f(step)) / 3.0L;
+}
+
+// The finite differences are only meaningful away from the places where ΔE2000 isn't differentiable.
+static bool is_smooth(const double *color) {
+	const double c_1 = std::hypot(color[1], color[2]), c_2 = std::hypot(color[4], color[5]);
+	const double c_7 = std::pow(0.5 * (c_1 + c_2), 7.0), g = 1.0 + 0.5 * (1.0 - std::sqrt(c_7 / (c_7 + 6103515625.0)));
+	const double h_1 = std::atan2(color[2], color[1] * g), h_2 = std::atan2(color[5], color[4] * g);
+	const double delta_h = std::fabs(std::remainder(h_2 - h_1, 2.0 * M_PI));
+	// The hue rotation term isn't periodic, so ΔE2000 also jumps slightly when a hue angle crosses 0.
+	return 0.1 < c_1 && 0.1 < c_2 && 1E-2 < M_PI - delta_h && 1E-2 < std::fabs(h_1) && 1E-2 < std::fabs(h_2)
+		&& 1E-2 < ciede_2000(color[0], color[1], color[2], color[3], color[4], color[5]);
+}
+
+int main(int argc, char *argv[]) {
+	// Usage : ./ciede-2000-gradient [number of pairs] [seed]
+	const long parsed_n = 1 < argc ? std::strtol(argv[1], nullptr, 10) : 0;
+	const int n = parsed_n < 1000 ? 1000000 : (int) std::min(parsed_n, 100000000L);
+	const uint64_t parsed_seed = std::strtoull(2 < argc ? argv[2] : "0", nullptr, 10);
+	uint64_t s = parsed_seed ? parsed_seed : (uint64_t) std::chrono::system_clock::now().time_since_epoch().count() | 1;
+
+	// Half of the pairs are arbitrary, the other half are close colors, like those met near an optimum.
+	std::vector<double> in[6], delta_e(n), grad_storage(6 * (size_t) n);
+	for (auto &v: in)
+		v.resize(n);
+	for (int i = 0; i < n; ++i) {
+		in[0][i] = uniform(s, 0.0, 100.0), in[1][i] = uniform(s, -128.0, 128.0), in[2][i] = uniform(s, -128.0, 128.0);
+		const double spread = i & 1 ? 3.0 : 128.0;
+		in[3][i] = i & 1 ? in[0][i] + uniform(s, -spread, spread) : uniform(s, 0.0, 100.0);
+		in[4][i] = in[1][i] * (i & 1) + uniform(s, -spread, spread);
+		in[5][i] = in[2][i] * (i & 1) + uniform(s, -spread, spread);
+	}
+	double *const grad[6] = {&grad_storage[0], &grad_storage[n], &grad_storage[2 * (size_t) n], &grad_storage[3 * (size_t) n], &grad_storage[4 * (size_t) n], &grad_storage[5 * (size_t) n]};
+
+	// Timings : one evaluation per pair, the analytic gradient, then the 13 calls of central finite differences.
+	double checksum = 0.0;
+	const auto time_1 = std::chrono::steady_clock::now();
+	for (int i = 0; i < n; ++i)
+		checksum += ciede_2000(in[0][i], in[1][i], in[2][i], in[3][i], in[4][i], in[5][i]);
+	const auto time_2 = std::chrono::steady_clock::now();
+	ciede_2000_grad(n, in[0].data(), in[1].data(), in[2].data(), in[3].data(), in[4].data(), in[5].data(), delta_e.data(), grad);
+	const auto time_3 = std::chrono::steady_clock::now();
+	const int n_fd = std::min(n, 100000);
+	for (int i = 0; i < n_fd; ++i) {
+		double x[6] = {in[0][i], in[1][i], in[2][i], in[3][i], in[4][i], in[5][i]};
+		checksum += ciede_2000(x[0], x[1], x[2], x[3], x[4], x[5]);
+		for (int k = 0; k < 6; ++k) {
+			const double x_k = x[k], step = 1E-6 * std::max(1.0, std::fabs(x_k));
+			x[k] = x_k + step;
+			const double hi = ciede_2000(x[0], x[1], x[2], x[3], x[4], x[5]);
+			x[k] = x_k - step;
+			checksum += (hi - ciede_2000(x[0], x[1], x[2], x[3], x[4], x[5])) / (2.0 * step);
+			x[k] = x_k;
+		}
+	}
+	const auto time_4 = std::chrono::steady_clock::now();
+
+	// Verification : the ΔE2000 must be identical to ciede_2000, the gradient close to the finite differences.
+	int n_mismatches = 0, n_checked = 0;
+	double max_error = 0.0;
+	const int n_verified = std::min(n, 200000);
+	for (int i = 0; i < n; ++i) {
+		const double color[6] = {in[0][i], in[1][i], in[2][i], in[3][i], in[4][i], in[5][i]};
+		n_mismatches += delta_e[i] != ciede_2000(color[0], color[1], color[2], color[3], color[4], color[5]);
+		if (n_verified <= i || !is_smooth(color))
+			continue;
+		++n_checked;
+		for (int k = 0; k < 6; ++k) {
+			const double reference = (double) finite_difference(color, k);
+			const double error = std::fabs(grad[k][i] - reference) / std::max(1.0, std::fabs(reference));
+			if (max_error < error)
+				max_error = error;
+		}
+	}
+
+	const double t_evaluation = std::chrono::duration<double>(time_2 - time_1).count() / n;
+	const double t_gradient = std::chrono::duration<double>(time_3 - time_2).count() / n;
+	const double t_finite = std::chrono::duration<double>(time_4 - time_3).count() / n_fd;
+	std::printf("ΔE2000 gradient on %d pairs (checksum %.3g).\n", n, checksum);
+	std::printf("One evaluation          : %6.1f ns per pair\n", t_evaluation * 1E9);
+	std::printf("Analytic gradient       : %6.1f ns per pair (%.2fx an evaluation)\n", t_gradient * 1E9, t_gradient / t_evaluation);
+	std::printf("Finite differences      : %6.1f ns per pair (%.2fx an evaluation)\n", t_finite * 1E9, t_finite / t_evaluation);
+	std::printf("ΔE2000 mismatches       : %d\n", n_mismatches);
+	std::printf("Maximum relative error  : %.3g, against extended precision finite differences on %d pairs\n", max_error, n_checked);
+	return n_mismatches == 0 && max_error < 1E-9 ? 0 : 1;
+}
+
+// The compilation is done using GCC or CLang :
+// - g++ -std=c++17 -Wall -Wextra -pedantic -O3 -o ciede-2000-gradient ciede-2000-gradient.cpp
+// - clang++ -std=c++17 -Wall -Wextra -pedantic -O3 -o ciede-2000-gradient ciede-2000-gradient.cpp
@@ -0,0 +1,428 @@
+// This function written in C++ is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#include <cmath>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327950288419716939937511
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+template<typename T>
+static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2) {
+	// Working in C++ with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+	// Application of the chroma correction factor.
+	const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	T h_1 = std::atan2(b_1, a_1 * n);
+	T h_2 = std::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+	n = std::fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
+		n = T(M_PI);
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	T h_m = (h_1 + h_2) * T(0.5);
+	T h_d = (h_2 - h_1) * T(0.5);
+	h_d += (T(M_PI) < n) * T(M_PI);
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (T(M_PI) < n) * T(M_PI);
+	// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+	const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+	n = (c_1 + c_2) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0)))
+			* std::sin(T(M_PI) / T(3.0) * std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI))));
+	n = (l_1 + l_2) * T(0.5);
+	n = (n - T(50.0)) * (n - T(50.0));
+	// Lightness.
+	const T l = (l_2 - l_1) / (k_l * (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+				- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+	n = c_1 + c_2;
+	// Hue.
+	const T h = T(2.0) * std::sqrt(c_1 * c_2) * std::sin(h_d) / (k_h * (T(1.0) + T(3.0) / T(400.0) * n * t));
+	// Chroma.
+	const T c = (c_2 - c_1) / (k_c * (T(1.0) + T(9.0) / T(400.0) * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 96.5   a1 = 47.8   b1 = 4.6
+// L2 = 96.8   a2 = 53.2   b2 = -4.1
+// CIE ΔE00 = 4.6680978034 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 4.6680847226 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.3e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////     Certified Bounds Over Boxes ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// For spatial indexes and branch-and-bound searches, this program computes guaranteed bounds [min, max] of the
+// ΔE2000 when each color ranges over an axis-aligned L*a*b* box (a point being a box of zero width). The steps
+// of the function above are evaluated in interval arithmetic, rounded outwards, and the hue logic is handled
+// explicitly : a box crossing the hue cut (the positive a axis) is split in two, and when the hue difference
+// may lie on both sides of π, both branches are evaluated and their results are joined.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+#include <vector>
+
+// A closed interval [lo, hi] whose operations are rounded outwards, so that it always contains the exact result.
+template<typename T>
+struct interval {
+	T lo, hi;
+
+	interval(const T x = T(0.0)) : lo(x), hi(x) {}
+	interval(const T l, const T h) : lo(l), hi(h) {}
+
+	// Widens the bounds by at least a number of units in the last place, covering the rounding of an operation.
+	static interval outward(const T l, const T h, const int ulps = 1) {
+		const T e = T(ulps) * std::numeric_limits<T>::epsilon(), tiny = T(ulps) * std::numeric_limits<T>::denorm_min();
+		return {l - (std::fabs(l) * e + tiny), h + (std::fabs(h) * e + tiny)};
+	}
+
+	bool contains(const T x) const { return lo <= x && x <= hi; }
+
+	friend interval operator+(const interval &x, const interval &y) { return outward(x.lo + y.lo, x.hi + y.hi); }
+	friend interval operator-(const interval &x, const interval &y) { return outward(x.lo - y.hi, x.hi - y.lo); }
+	friend interval operator*(const interval &x, const interval &y) {
+		const T p[4] = {x.lo * y.lo, x.lo * y.hi, x.hi * y.lo, x.hi * y.hi};
+		return outward(*std::min_element(p, p + 4), *std::max_element(p, p + 4));
+	}
+	friend interval operator/(const interval &x, const interval &y) {
+		// The divisors met in ΔE2000 (the weighting functions S_L, S_C and S_H) are all positive.
+		const T p[4] = {x.lo / y.lo, x.lo / y.hi, x.hi / y.lo, x.hi / y.hi};
+		return outward(*std::min_element(p, p + 4), *std::max_element(p, p + 4));
+	}
+	friend interval hull(const interval &x, const interval &y) { return {std::min(x.lo, y.lo), std::max(x.hi, y.hi)}; }
+	friend interval intersect(const interval &x, const interval &y) { return {std::max(x.lo, y.lo), std::min(x.hi, y.hi)}; }
+	friend interval sqr(const interval &x) {
+		// Unlike x * x, the square of an interval containing 0 can't be negative.
+		const T a = x.lo * x.lo, b = x.hi * x.hi;
+		return x.contains(T(0.0)) ? outward(T(0.0), std::max(a, b)) : outward(std::min(a, b), std::max(a, b));
+	}
+	friend interval fabs(const interval &x) { return x.contains(T(0.0)) ? interval(T(0.0), std::max(-x.lo, x.hi)) : x.lo < T(0.0) ? interval(-x.hi, -x.lo) : x; }
+	friend interval sqrt(const interval &x) { return outward(std::sqrt(std::max(T(0.0), x.lo)), std::sqrt(std::max(T(0.0), x.hi))); }
+	friend interval exp(const interval &x) { return outward(std::exp(x.lo), std::exp(x.hi), 2); }
+	friend interval sin(const interval &x) {
+		// The extrema are reached at the bounds, or at the peaks π/2 + 2kπ and troughs -π/2 + 2kπ inside the interval.
+		const T two_pi = T(2.0) * T(M_PI), slack = T(1E-12);
+		if (two_pi <= x.hi - x.lo)
+			return {T(-1.0), T(1.0)};
+		const T s_1 = std::sin(x.lo), s_2 = std::sin(x.hi);
+		interval r = outward(std::min(s_1, s_2), std::max(s_1, s_2), 2);
+		if (std::ceil((x.lo - slack - T(M_PI) / T(2.0)) / two_pi) * two_pi + T(M_PI) / T(2.0) <= x.hi + slack)
+			r.hi = T(1.0);
+		if (std::ceil((x.lo - slack + T(M_PI) / T(2.0)) / two_pi) * two_pi - T(M_PI) / T(2.0) <= x.hi + slack)
+			r.lo = T(-1.0);
+		return r;
+	}
+};
+
+// Applies an increasing function of one variable to both bounds, an exact and narrow evaluation.
+template<typename T, typename F>
+static interval<T> increasing(const interval<T> &x, const F &f) {
+	return interval<T>::outward(f(x.lo), f(x.hi), 4);
+}
+
+// The range of the hue angle in [0, 2π] of the points of a box, which doesn't cross the positive a axis. When
+// "below" is set, the box has been cut at b = 0 from below, and its points at b = 0 are considered close to 2π.
+template<typename T>
+static interval<T> hue_range(const interval<T> &a, const interval<T> &b, const bool below) {
+	if (a.contains(T(0.0)) && b.contains(T(0.0)))
+		return {T(0.0), T(2.0) * T(M_PI)};
+	// Seen from the origin, the angles covered by a box are bounded by those of its corners.
+	T lo = std::numeric_limits<T>::infinity(), hi = -lo;
+	for (const T x: {a.lo, a.hi})
+		for (const T y: {b.lo, b.hi}) {
+			T h = std::atan2(y, x);
+			h += (h < T(0.0)) * T(2.0) * T(M_PI);
+			if (below && y == T(0.0) && T(0.0) < x)
+				h = T(2.0) * T(M_PI);
+			lo = std::min(lo, h), hi = std::max(hi, h);
+		}
+	return interval<T>::outward(lo, hi, 4);
+}
+
+// The end of the computation, from the hue angles, for a given choice of the hue wrapping.
+template<typename T>
+static interval<T> ciede_2000_tail(const interval<T> &l_1, const interval<T> &l_2, const interval<T> &c_1, const interval<T> &c_2, const interval<T> &h_sum, const interval<T> &h_diff, const bool wrap) {
+	using I = interval<T>;
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	const I h_m = h_sum * I(T(0.5)) + I(T(wrap) * T(M_PI));
+	const I h_d = h_diff * I(T(0.5)) + I(T(wrap) * T(M_PI));
+	const I p = I(T(36.0)) * h_m - I(T(55.0) * T(M_PI));
+	// The exponential lies in [0, 1], where the sine of the hue rotation term is increasing.
+	const I e = increasing(sqr(p), [](const T x) { return std::exp(x / (T(-25.0) * T(M_PI) * T(M_PI))); });
+	const I r_c = increasing((c_1 + c_2) * I(T(0.5)), [](const T x) { const T x_7 = x * x * x * x * x * x * x; return std::sqrt(x_7 / (x_7 + T(6103515625.0))); });
+	const I r_t = I(T(-2.0)) * r_c * increasing(e, [](const T x) { return std::sin(T(M_PI) / T(3.0) * x); });
+	const I u = sqr((l_1 + l_2) * I(T(0.5)) - I(T(50.0)));
+	const I s_l = increasing(u, [k_l](const T x) { return k_l * (T(1.0) + T(3.0) / T(200.0) * x / std::sqrt(T(20.0) + x)); });
+	const I l = (l_2 - l_1) / s_l;
+	const I t = I(T(1.0)) + I(T(6.0) / T(25.0)) * sin(I(T(2.0)) * h_m + I(T(M_PI) / T(2.0)))
+				+ I(T(8.0) / T(25.0)) * sin(I(T(3.0)) * h_m + I(T(8.0) * T(M_PI) / T(15.0)))
+				- I(T(17.0) / T(100.0)) * sin(h_m + I(T(M_PI) / T(3.0)))
+				- I(T(1.0) / T(5.0)) * sin(I(T(4.0)) * h_m + I(T(3.0) * T(M_PI) / T(20.0)));
+	const I n = c_1 + c_2;
+	const I h = I(T(2.0)) * sqrt(c_1 * c_2) * sin(h_d) / (I(k_h) * (I(T(1.0)) + I(T(3.0) / T(400.0)) * n * t));
+	const I c = (c_2 - c_1) / (I(k_c) * (I(T(1.0)) + I(T(9.0) / T(400.0)) * n));
+	return sqrt(sqr(l) + sqr(h) + sqr(c) + c * h * r_t);
+}
+
+// The bounds of the ΔE2000 once the boxes have been cut along the hue cut.
+template<typename T>
+static interval<T> ciede_2000_piece(const interval<T> &l_1, const interval<T> &a_1, const interval<T> &b_1, const bool below_1, const interval<T> &l_2, const interval<T> &a_2, const interval<T> &b_2, const bool below_2) {
+	using I = interval<T>;
+	const I c_mean = (sqrt(sqr(a_1) + sqr(b_1)) + sqrt(sqr(a_2) + sqr(b_2))) * I(T(0.5));
+	// The G factor decreases when the mean chroma increases.
+	const I rc = increasing(c_mean, [](const T x) { const T x_7 = x * x * x * x * x * x * x; return std::sqrt(x_7 / (x_7 + T(6103515625.0))); });
+	const I g = I(T(1.0)) + I(T(0.5)) * (I(T(1.0)) - rc);
+	const I a_1_prime = a_1 * g, a_2_prime = a_2 * g;
+	const I c_1 = sqrt(sqr(a_1_prime) + sqr(b_1));
+	const I c_2 = sqrt(sqr(a_2_prime) + sqr(b_2));
+	const I h_1 = hue_range(a_1_prime, b_1, below_1);
+	const I h_2 = hue_range(a_2_prime, b_2, below_2);
+	const I h_sum = h_1 + h_2, h_diff = h_2 - h_1, n = fabs(h_diff);
+	// The hue difference wraps when it exceeds π (beyond the rounding band of 1E-14), both cases may happen.
+	const T pi = T(M_PI), margin = T(1E-13);
+	I result(std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity());
+	if (n.lo < pi + margin)
+		result = hull(result, ciede_2000_tail(l_1, l_2, c_1, c_2, h_sum, intersect(h_diff, I(-pi - margin, pi + margin)), false));
+	if (pi - margin < n.hi) {
+		if (pi - margin < h_diff.hi)
+			result = hull(result, ciede_2000_tail(l_1, l_2, c_1, c_2, h_sum, intersect(h_diff, I(pi - margin, T(2.0) * pi)), true));
+		if (h_diff.lo < -pi + margin)
+			result = hull(result, ciede_2000_tail(l_1, l_2, c_1, c_2, h_sum, intersect(h_diff, I(T(-2.0) * pi, -pi + margin)), true));
+	}
+	return result;
+}
+
+// Returns guaranteed bounds [min, max] of ciede_2000 when each component of both colors ranges over an interval.
+// A color given by points (lo == hi) gives the box-vs-point bounds, used to prune the nodes of a spatial index.
+template<typename T>
+static interval<T> ciede_2000(const interval<T> &l_1, const interval<T> &a_1, const interval<T> &b_1, const interval<T> &l_2, const interval<T> &a_2, const interval<T> &b_2) {
+	using I = interval<T>;
+	// A box straddling the positive a axis is cut at b = 0, since its hue angles are close to both 0 and 2π.
+	const auto cut = [](const I &a, const I &b, I *pieces, bool *below) {
+		if (T(0.0) < a.lo && b.lo < T(0.0) && T(0.0) <= b.hi) {
+			pieces[0] = I(T(0.0), b.hi), below[0] = false;
+			pieces[1] = I(b.lo, T(0.0)), below[1] = true;
+			return 2;
+		}
+		pieces[0] = b, below[0] = false;
+		return 1;
+	};
+	I pieces_1[2], pieces_2[2];
+	bool below_1[2], below_2[2];
+	const int n_1 = cut(a_1, b_1, pieces_1, below_1), n_2 = cut(a_2, b_2, pieces_2, below_2);
+	I result(std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity());
+	for (int i = 0; i < n_1; ++i)
+		for (int j = 0; j < n_2; ++j)
+			result = hull(result, ciede_2000_piece(l_1, a_1, pieces_1[i], below_1[i], l_2, a_2, pieces_2[j], below_2[j]));
+	// The bounds also cover the rounding errors of ciede_2000 itself, which are below 1E-13.
+	return {std::max(T(0.0), result.lo - T(1E-12) * (T(1.0) + result.lo)), result.hi + T(1E-12) * (T(1.0) + result.hi)};
+}
+
+static inline uint64_t xor_random(uint64_t &s) {
+	return s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+}
+
+static inline double uniform(uint64_t &s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// A random sRGB color converted to L*a*b* (illuminant D65), like the colors of a typical palette.
+static void random_lab(uint64_t &s, double *lab) {
+	double xyz[3] = {0.0, 0.0, 0.0};
+	static const double m[3][3] = {{0.4124564, 0.3575761, 0.1804375}, {0.2126729, 0.7151522, 0.0721750}, {0.0193339, 0.1191920, 0.9503041}};
+	static const double white[3] = {0.95047, 1.0, 1.08883};
+	for (int k = 0; k < 3; ++k) {
+		const double c = (double) (xor_random(s) & 255) / 255.0, linear = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+		for (int i = 0; i < 3; ++i)
+			xyz[i] += m[i][k] * linear;
+	}
+	for (int i = 0; i < 3; ++i)
+		xyz[i] = xyz[i] / white[i] > 216.0 / 24389.0 ? std::cbrt(xyz[i] / white[i]) : (24389.0 / 27.0 * xyz[i] / white[i] + 16.0) / 116.0;
+	lab[0] = 116.0 * xyz[1] - 16.0, lab[1] = 500.0 * (xyz[0] - xyz[1]), lab[2] = 200.0 * (xyz[1] - xyz[2]);
+}
+
+// A k-d tree over the palette, each node knowing the bounding box of its colors.
+struct kd_node {
+	interval<double> box[3];
+	int begin, end, left, right;
+};
+
+static int build(std::vector<kd_node> &nodes, std::vector<int> &order, const std::vector<double> &palette, const int begin, const int end) {
+	kd_node node{};
+	node.begin = begin, node.end = end, node.left = node.right = -1;
+	for (int k = 0; k < 3; ++k) {
+		node.box[k] = interval<double>(std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity());
+		for (int i = begin; i < end; ++i)
+			node.box[k] = hull(node.box[k], interval<double>(palette[3 * order[i] + k]));
+	}
+	const int index = (int) nodes.size();
+	nodes.push_back(node);
+	if (end - begin > 4) {
+		// The widest dimension is split at its median.
+		int axis = 0;
+		for (int k = 1; k < 3; ++k)
+			if (node.box[axis].hi - node.box[axis].lo < node.box[k].hi - node.box[k].lo)
+				axis = k;
+		const int middle = (begin + end) / 2;
+		std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](const int x, const int y) { return palette[3 * x + axis] < palette[3 * y + axis]; });
+		const int left = build(nodes, order, palette, begin, middle);
+		const int right = build(nodes, order, palette, middle, end);
+		nodes[index].left = left, nodes[index].right = right;
+	}
+	return index;
+}
+
+int main(int argc, char *argv[]) {
+	// Usage : ./ciede-2000-interval [palette size] [number of queries] [seed]
+	const long parsed_palette = 1 < argc ? std::strtol(argv[1], nullptr, 10) : 0;
+	const int n_palette = parsed_palette < 16 ? 4096 : (int) std::min(parsed_palette, 10000000L);
+	const long parsed_queries = 2 < argc ? std::strtol(argv[2], nullptr, 10) : 0;
+	const int n_queries = parsed_queries < 1 ? 20000 : (int) std::min(parsed_queries, 10000000L);
+	const uint64_t parsed_seed = std::strtoull(3 < argc ? argv[3] : "0", nullptr, 10);
+	uint64_t s = parsed_seed ? parsed_seed : (uint64_t) std::chrono::system_clock::now().time_since_epoch().count() | 1;
+
+	// 1. Soundness : the ΔE2000 of points sampled in random boxes (box-vs-point and box-vs-box) lies in the bounds.
+	long n_samples = 0, n_violations = 0;
+	double sum_width = 0.0;
+	const int n_boxes = 20000;
+	for (int i = 0; i < n_boxes; ++i) {
+		interval<double> box[6];
+		for (int k = 0; k < 6; ++k) {
+			// Some boxes are centered on the a and b axes, to exercise the hue cut, achromatic colors and π apart hues.
+			const bool degenerate = k >= 3 && (i & 1);
+			const double center = k % 3 == 0 ? uniform(s, 0.0, 100.0) : xor_random(s) & 3 ? uniform(s, -128.0, 128.0) : uniform(s, -1.0, 1.0);
+			const double width = degenerate ? 0.0 : std::pow(10.0, uniform(s, -3.0, 1.5));
+			box[k] = interval<double>(center - width, center + width);
+		}
+		const interval<double> bounds = ciede_2000(box[0], box[1], box[2], box[3], box[4], box[5]);
+		sum_width += bounds.hi - bounds.lo;
+		for (int j = 0; j < 64; ++j, ++n_samples) {
+			double x[6];
+			for (int k = 0; k < 6; ++k)
+				x[k] = j < 8 && ((j >> (k % 3)) & 1) ? box[k].hi : j < 8 ? box[k].lo : uniform(s, box[k].lo, box[k].hi);
+			const double delta_e = ciede_2000(x[0], x[1], x[2], x[3], x[4], x[5]);
+			n_violations += !bounds.contains(delta_e);
+		}
+	}
+
+	// 2. Nearest color queries over a palette, by a best-first branch-and-bound search in the k-d tree.
+	std::vector<double> palette(3 * (size_t) n_palette), queries(3 * (size_t) n_queries);
+	for (int i = 0; i < n_palette; ++i)
+		random_lab(s, &palette[3 * (size_t) i]);
+	for (int i = 0; i < n_queries; ++i)
+		random_lab(s, &queries[3 * (size_t) i]);
+	std::vector<kd_node> nodes;
+	std::vector<int> order(n_palette);
+	for (int i = 0; i < n_palette; ++i)
+		order[i] = i;
+	build(nodes, order, palette, 0, n_palette);
+
+	long n_evaluations = 0, n_bounds = 0, n_wrong = 0;
+	std::vector<int> nearest(n_queries);
+	const auto time_1 = std::chrono::steady_clock::now();
+	for (int q = 0; q < n_queries; ++q) {
+		const double *x = &queries[3 * (size_t) q];
+		const interval<double> point[3] = {x[0], x[1], x[2]};
+		typedef std::pair<double, int> entry;
+		std::priority_queue<entry, std::vector<entry>, std::greater<entry>> heap;
+		heap.push({0.0, 0});
+		double best = std::numeric_limits<double>::infinity();
+		int best_index = -1;
+		while (!heap.empty() && heap.top().first <= best) {
+			const kd_node &node = nodes[heap.top().second];
+			heap.pop();
+			if (node.left < 0) {
+				for (int i = node.begin; i < node.end; ++i) {
+					const double *y = &palette[3 * (size_t) order[i]];
+					const double delta_e = ciede_2000(x[0], x[1], x[2], y[0], y[1], y[2]);
+					++n_evaluations;
+					if (delta_e < best || (delta_e == best && order[i] < best_index))
+						best = delta_e, best_index = order[i];
+				}
+				continue;
+			}
+			for (const int child: {node.left, node.right}) {
+				const kd_node &c = nodes[child];
+				const double lower = ciede_2000(point[0], point[1], point[2], c.box[0], c.box[1], c.box[2]).lo;
+				++n_bounds;
+				if (lower <= best)
+					heap.push({lower, child});
+			}
+		}
+		nearest[q] = best_index;
+	}
+	const auto time_2 = std::chrono::steady_clock::now();
+	for (int q = 0; q < n_queries; ++q) {
+		const double *x = &queries[3 * (size_t) q];
+		double best = std::numeric_limits<double>::infinity();
+		int best_index = -1;
+		for (int i = 0; i < n_palette; ++i) {
+			const double *y = &palette[3 * (size_t) i];
+			const double delta_e = ciede_2000(x[0], x[1], x[2], y[0], y[1], y[2]);
+			if (delta_e < best)
+				best = delta_e, best_index = i;
+		}
+		const double *y = &palette[3 * (size_t) nearest[q]];
+		n_wrong += best_index != nearest[q] && best != ciede_2000(x[0], x[1], x[2], y[0], y[1], y[2]);
+	}
+	const auto time_3 = std::chrono::steady_clock::now();
+
+	const double t_search = std::chrono::duration<double>(time_2 - time_1).count(), t_brute = std::chrono::duration<double>(time_3 - time_2).count();
+	std::printf("Soundness : %ld points sampled in %d random boxes, %ld outside of the bounds, mean width %.3g.\n", n_samples, n_boxes, n_violations, sum_width / n_boxes);
+	std::printf("Nearest color among %d sRGB colors, for %d queries :\n", n_palette, n_queries);
+	std::printf("- branch-and-bound : %.1f ΔE2000 and %.1f bounds per query, %.1f%% of candidates pruned, %.3f s\n", (double) n_evaluations / n_queries, (double) n_bounds / n_queries, 100.0 * (1.0 - (double) n_evaluations / ((double) n_queries * n_palette)), t_search);
+	std::printf("- brute force      : %d ΔE2000 per query, %.3f s, %ld different answers\n", n_palette, t_brute, n_wrong);
+	return n_violations == 0 && n_wrong == 0 ? 0 : 1;
+}
+
+// The compilation is done using GCC or CLang :
+// - g++ -std=c++17 -Wall -Wextra -pedantic -O3 -o ciede-2000-interval ciede-2000-interval.cpp
+// - clang++ -std=c++17 -Wall -Wextra -pedantic -O3 -o ciede-2000-interval ciede-2000-interval.cpp
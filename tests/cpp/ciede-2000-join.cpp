@@ -0,0 +1,414 @@
+// This function written in C++ is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+#include <cmath>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327950288419716939937511
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+template<typename T>
+static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2) {
+	// Working in C++ with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+	// Application of the chroma correction factor.
+	const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	T h_1 = std::atan2(b_1, a_1 * n);
+	T h_2 = std::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+	n = std::fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
+		n = T(M_PI);
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	T h_m = (h_1 + h_2) * T(0.5);
+	T h_d = (h_2 - h_1) * T(0.5);
+	h_d += (T(M_PI) < n) * T(M_PI);
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (T(M_PI) < n) * T(M_PI);
+	// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+	const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+	n = (c_1 + c_2) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0)))
+			* std::sin(T(M_PI) / T(3.0) * std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI))));
+	n = (l_1 + l_2) * T(0.5);
+	n = (n - T(50.0)) * (n - T(50.0));
+	// Lightness.
+	const T l = (l_2 - l_1) / (k_l * (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+				- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+	n = c_1 + c_2;
+	// Hue.
+	const T h = T(2.0) * std::sqrt(c_1 * c_2) * std::sin(h_d) / (k_h * (T(1.0) + T(3.0) / T(400.0) * n * t));
+	// Chroma.
+	const T c = (c_2 - c_1) / (k_c * (T(1.0) + T(9.0) / T(400.0) * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 96.5   a1 = 47.8   b1 = 4.6
+// L2 = 96.8   a2 = 53.2   b2 = -4.1
+// CIE ΔE00 = 4.6680978034 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 4.6680847226 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.3e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////        Similarity Join          ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// Finds every pair (i, j) such that ΔE2000(colors_1[i], colors_2[j]) <= τ, without evaluating the N x M pairs.
+// Both sets are partitioned into cubic cells of a Lab grid, whose bounding boxes give a lower bound of the
+// ΔE2000 between any two of their colors, and only the pairs of cells whose bound is below τ are evaluated.
+
+// The bound follows from the terms of the formula, for any hue and both conventions of the hue mean :
+// - the lightness term is ΔL / S_L, where S_L <= 1.747 in the domain, and grows with |L̄ - 50|
+// - ΔC'² + ΔH'² is the squared distance between (a', b') points, and a' = G * a with G >= 1, so it is at
+//   least the squared distance between the (a, b) points
+// - S_H <= S_C = 1 + 0.045 * C̄' (T < 1.93 < 3), and C' <= G * C, where G decreases with the chroma
+// - the rotation term satisfies |R_T| <= √3 * R_C, so c² + h² + R_T * c * h >= (1 - √3 / 2 * R_C) * (c² + h²)
+// Hence ΔE2000² >= (ΔL / S_L)² + (1 - √3 / 2 * R_C) * (Δab / S_C)², with the worst S_L, S_C and R_C of the
+// two boxes. The same bound gives the reach of a cell, how far in L and in (a, b) its partners can lie.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+
+namespace ciede_2000_join_detail {
+
+	using color = std::array<double, 3>;
+
+	struct box {
+		color min, max;
+	};
+
+	struct cell {
+		int64_t x, y, z;
+		size_t begin, end; // the colors of the cell, in the sorted order of its grid
+		box bounds;
+		double c_min, c_max; // the chroma range of its colors
+	};
+
+	struct grid {
+		double side;
+		std::vector<size_t> index; // the original index of each color, in the sorted order
+		std::vector<color> colors;
+		std::vector<cell> cells;
+		std::vector<uint64_t> keys; // the sorted keys of the cells, the z coordinate varying the fastest
+	};
+
+	inline uint64_t pack(const int64_t x, const int64_t y, const int64_t z) {
+		// 21 bits per coordinate, which covers any Lab color with cells larger than 0.001.
+		return (uint64_t) (x + (1 << 20)) << 42 | (uint64_t) (y + (1 << 20)) << 21 | (uint64_t) (z + (1 << 20));
+	}
+
+	template<typename It>
+	grid build(It first, const size_t n, const double side) {
+		grid g;
+		g.side = side;
+		std::vector<std::pair<uint64_t, size_t>> keys(n);
+		for (size_t i = 0; i < n; ++i, ++first) {
+			const auto &c = *first;
+			keys[i] = {pack((int64_t) std::floor(c[0] / side), (int64_t) std::floor(c[1] / side), (int64_t) std::floor(c[2] / side)), i};
+			g.colors.push_back({c[0], c[1], c[2]});
+		}
+		std::sort(keys.begin(), keys.end());
+		std::vector<color> sorted(n);
+		g.index.resize(n);
+		for (size_t i = 0; i < n; ++i)
+			g.index[i] = keys[i].second, sorted[i] = g.colors[keys[i].second];
+		g.colors.swap(sorted);
+		for (size_t i = 0; i < n;) {
+			size_t j = i;
+			cell c = {0, 0, 0, i, i, {g.colors[i], g.colors[i]}, 0.0, 0.0};
+			for (; j < n && keys[j].first == keys[i].first; ++j)
+				for (int k = 0; k < 3; ++k)
+					c.bounds.min[k] = std::min(c.bounds.min[k], g.colors[j][k]), c.bounds.max[k] = std::max(c.bounds.max[k], g.colors[j][k]);
+			c.end = j;
+			// The smallest and the largest chroma of the colors of the cell.
+			const box &b = c.bounds;
+			const double gap_a = std::max({0.0, b.min[1], -b.max[1]}), gap_b = std::max({0.0, b.min[2], -b.max[2]});
+			const double far_a = std::max(-b.min[1], b.max[1]), far_b = std::max(-b.min[2], b.max[2]);
+			c.c_min = std::hypot(gap_a, gap_b), c.c_max = std::hypot(far_a, far_b);
+			c.x = (int64_t) (keys[i].first >> 42) - (1 << 20), c.y = (int64_t) (keys[i].first >> 21 & 0x1FFFFF) - (1 << 20), c.z = (int64_t) (keys[i].first & 0x1FFFFF) - (1 << 20);
+			g.keys.push_back(keys[i].first);
+			g.cells.push_back(c);
+			i = j;
+		}
+		return g;
+	}
+
+	inline double s_l(const double l_mean) {
+		const double n = (l_mean - 50.0) * (l_mean - 50.0);
+		return 1.0 + 0.015 * n / std::sqrt(20.0 + n);
+	}
+
+	// The R_C term of the formula, which is also 2 * (1.5 - G) when computed from the mean of the raw chromas.
+	inline double r_c(const double c_mean) {
+		const double c_2 = c_mean * c_mean, n = c_2 * c_2 * c_2 * c_mean;
+		return std::sqrt(n / (n + 6103515625.0));
+	}
+
+	inline double g_factor(const double c_mean) {
+		return 1.5 - 0.5 * r_c(c_mean);
+	}
+
+	// For any color of the cell p and any color of the cell q, ΔE2000² >= k_l * ΔL² + k_ab * (Δa² + Δb²).
+	struct bound {
+		double k_l, k_ab;
+		double operator()(const double d_l, const double d_a, const double d_b) const {
+			return k_l * d_l * d_l + k_ab * (d_a * d_a + d_b * d_b);
+		}
+	};
+
+	inline bound lower_bound(const cell &p, const cell &q) {
+		const double l_low = (p.bounds.min[0] + q.bounds.min[0]) * 0.5, l_high = (p.bounds.max[0] + q.bounds.max[0]) * 0.5;
+		const double worst_s_l = std::max(s_l(l_low), s_l(l_high));
+		const double c_mean_max = g_factor((p.c_min + q.c_min) * 0.5) * (p.c_max + q.c_max) * 0.5;
+		const double worst_s_c = 1.0 + 0.045 * c_mean_max;
+		const double rotation = 1.0 - 0.8660254037844386 * r_c(c_mean_max);
+		return {1.0 / (worst_s_l * worst_s_l), rotation / (worst_s_c * worst_s_c)};
+	}
+
+	// How far in L and in (a, b) a color whose ΔE2000 to some color of the cell is at most τ can lie.
+	inline std::pair<double, double> reach(const cell &p, const double tau) {
+		// The partner's chroma is at least 0, so G is at most g_factor(c_min / 2).
+		const double g = g_factor(p.c_min * 0.5);
+		double r = tau;
+		for (int i = 0; i < 64 && r < 512.0; ++i) {
+			// The partner's chroma is at most c_max + r.
+			const double c_mean_max = g * (p.c_max + r * 0.5);
+			r = tau * (1.0 + 0.045 * c_mean_max) / std::sqrt(1.0 - 0.8660254037844386 * r_c(c_mean_max));
+		}
+		return {tau * s_l(0.0), std::min(r, 512.0)};
+	}
+
+	struct triple {
+		size_t i, j;
+		double delta_e;
+	};
+}
+
+// The statistics of a join : the number of pairs found, and of pairs evaluated with ciede_2000.
+struct ciede_2000_join_stats {
+	uint64_t n_found, n_evaluated;
+};
+
+// Calls emit(const std::vector<triple> &) with batches of (i, j, ΔE2000) such that ΔE2000 <= τ, one batch at a
+// time but in no particular order, while the threads are working. With self_join, both ranges are the same
+// set, and each pair i < j is reported once.
+template<typename It_1, typename It_2, typename Emit>
+static ciede_2000_join_stats ciede_2000_join(It_1 first_1, const size_t n_1, It_2 first_2, const size_t n_2, const double tau, const bool self_join, Emit &&emit, int n_threads = 0) {
+	using namespace ciede_2000_join_detail;
+	// The cell side is at least the reach in lightness, and large enough for the cells to hold a few colors,
+	// since the neighborhood of a cell spans its reach in (a, b), which is much larger at high chroma.
+	box extent = {{0.0, -128.0, -128.0}, {100.0, 128.0, 128.0}};
+	It_1 it_1 = first_1;
+	for (size_t i = 0; i < n_1; ++i, ++it_1)
+		for (int k = 0; k < 3; ++k)
+			extent.min[k] = std::min(extent.min[k], (*it_1)[k]), extent.max[k] = std::max(extent.max[k], (*it_1)[k]);
+	const double volume = (extent.max[0] - extent.min[0]) * (extent.max[1] - extent.min[1]) * (extent.max[2] - extent.min[2]);
+	const double side = std::max({tau * s_l(0.0), std::cbrt(volume * 4.0 / (double) std::max<size_t>(n_1, 1)), 0.05});
+	const grid g_1 = build(first_1, n_1, side);
+	const grid g_2 = self_join ? grid() : build(first_2, n_2, side);
+	const grid &h = self_join ? g_1 : g_2;
+	if (n_threads <= 0)
+		n_threads = (int) std::max(1U, std::thread::hardware_concurrency());
+	// The bound is relaxed by a relative 1E-9 to absorb its rounding errors.
+	const double tau_2 = tau * tau * (1.0 + 1E-9);
+	std::atomic<size_t> next_cell(0);
+	std::atomic<uint64_t> n_found(0), n_evaluated(0);
+	std::mutex emit_mutex;
+	const auto work = [&] {
+		std::vector<triple> batch;
+		uint64_t found = 0, evaluated = 0;
+		const auto flush = [&] {
+			std::lock_guard<std::mutex> lock(emit_mutex);
+			emit((const std::vector<triple> &) batch);
+			batch.clear();
+		};
+		for (size_t k; (k = next_cell.fetch_add(1, std::memory_order_relaxed)) < g_1.cells.size();) {
+			const cell &p = g_1.cells[k];
+			const auto r = reach(p, tau);
+			const int64_t d_l = (int64_t) std::ceil(r.first / side), d_ab = (int64_t) std::ceil(r.second / side);
+			for (int64_t x = p.x - d_l; x <= p.x + d_l; ++x)
+				for (int64_t y = p.y - d_ab; y <= p.y + d_ab; ++y) {
+					// The cells of a column are consecutive in the sorted keys.
+					const uint64_t last = pack(x, y, p.z + d_ab);
+					size_t m = (size_t) (std::lower_bound(h.keys.begin(), h.keys.end(), pack(x, y, p.z - d_ab)) - h.keys.begin());
+					if (self_join)
+						m = std::max(m, k);
+					for (; m < h.keys.size() && h.keys[m] <= last; ++m) {
+						const cell &q = h.cells[m];
+						// The bound is first applied to the gaps between the boxes, then to each pair of colors.
+						const bound lower = lower_bound(p, q);
+						const auto gap = [&](const int c) { return std::max({0.0, q.bounds.min[c] - p.bounds.max[c], p.bounds.min[c] - q.bounds.max[c]}); };
+						if (tau_2 < lower(gap(0), gap(1), gap(2)))
+							continue;
+						for (size_t i = p.begin; i < p.end; ++i)
+							for (size_t j = self_join && m == k ? i + 1 : q.begin; j < q.end; ++j) {
+								const color *c_1 = &g_1.colors[i], *c_2 = &h.colors[j];
+								if (tau_2 < lower((*c_1)[0] - (*c_2)[0], (*c_1)[1] - (*c_2)[1], (*c_1)[2] - (*c_2)[2]))
+									continue;
+								size_t a = g_1.index[i], b = h.index[j];
+								// The self-join reports ciede_2000(colors[a], colors[b]) with a < b, to the last bit.
+								if (self_join && b < a)
+									std::swap(a, b), std::swap(c_1, c_2);
+								const double delta_e = ciede_2000<double>((*c_1)[0], (*c_1)[1], (*c_1)[2], (*c_2)[0], (*c_2)[1], (*c_2)[2]);
+								++evaluated;
+								if (delta_e <= tau) {
+									batch.push_back({a, b, delta_e});
+									++found;
+								}
+							}
+						if (65536 <= batch.size())
+							flush();
+					}
+				}
+		}
+		if (!batch.empty())
+			flush();
+		n_found += found, n_evaluated += evaluated;
+	};
+	std::vector<std::thread> threads;
+	for (int i = 1; i < n_threads; ++i)
+		threads.emplace_back(work);
+	work();
+	for (auto &t : threads)
+		t.join();
+	return {n_found.load(), n_evaluated.load()};
+}
+
+static inline uint64_t xor_random(uint64_t &s) {
+	return s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+}
+
+static inline double uniform(uint64_t &s, const double min, const double max) {
+	return min + (max - min) * (double) (xor_random(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+template<typename F>
+static double seconds(const F &f) {
+	const auto t_1 = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t_1).count();
+}
+
+int main(int argc, char *argv[]) {
+	// Usage : ./ciede-2000-join [size of the catalog] [size of the library] [τ] [seed] [output file]
+	using ciede_2000_join_detail::triple;
+	using color = std::array<double, 3>;
+	const long parsed_1 = 1 < argc ? std::strtol(argv[1], nullptr, 10) : 0, parsed_2 = 2 < argc ? std::strtol(argv[2], nullptr, 10) : 0;
+	const size_t n_1 = parsed_1 < 1 ? 1000000 : (size_t) parsed_1, n_2 = parsed_2 < 1 ? 1000000 : (size_t) parsed_2;
+	const double parsed_tau = 3 < argc ? std::strtod(argv[3], nullptr) : 0.0, tau = 0.0 < parsed_tau ? parsed_tau : 1.0;
+	const uint64_t parsed_seed = std::strtoull(4 < argc ? argv[4] : "0", nullptr, 10);
+	uint64_t s = parsed_seed ? parsed_seed : (uint64_t) std::chrono::system_clock::now().time_since_epoch().count() | 1;
+	FILE *out = 5 < argc ? std::fopen(argv[5], "w") : nullptr;
+	if (5 < argc && !out) {
+		std::perror("Delta E 2000");
+		return 3;
+	}
+	const auto random_color = [&] { return color{uniform(s, 0.0, 100.0), uniform(s, -128.0, 128.0), uniform(s, -128.0, 128.0)}; };
+	// The catalog contains slightly shifted copies of some colors of the library, and new colors.
+	std::vector<color> catalog(n_1), library(n_2);
+	for (auto &c : library)
+		c = random_color();
+	for (auto &c : catalog)
+		if (xor_random(s) & 1) {
+			c = library[xor_random(s) % n_2];
+			for (int k = 0; k < 3; ++k)
+				c[k] += uniform(s, -tau, tau);
+		} else
+			c = random_color();
+
+	// A subset is first joined by brute force, both joins must report the same pairs.
+	int n_errors = 0;
+	const size_t m_1 = std::min<size_t>(n_1, 3000), m_2 = std::min<size_t>(n_2, 3000);
+	for (const bool self_join : {false, true}) {
+		std::vector<std::tuple<size_t, size_t, double>> expected, got;
+		for (size_t i = 0; i < m_1; ++i)
+			for (size_t j = self_join ? i + 1 : 0; j < (self_join ? m_1 : m_2); ++j) {
+				const color &c_1 = catalog[i], &c_2 = self_join ? catalog[j] : library[j];
+				const double delta_e = ciede_2000<double>(c_1[0], c_1[1], c_1[2], c_2[0], c_2[1], c_2[2]);
+				if (delta_e <= tau)
+					expected.emplace_back(i, j, delta_e);
+			}
+		ciede_2000_join(catalog.begin(), m_1, library.begin(), m_2, tau, self_join, [&](const std::vector<triple> &batch) {
+			for (const auto &t : batch)
+				got.emplace_back(t.i, t.j, t.delta_e);
+		});
+		std::sort(got.begin(), got.end());
+		const bool ok = got == expected;
+		n_errors += !ok;
+		std::printf("%s of %zu x %zu colors with τ = %g : %zu pairs, %s the brute force.\n", self_join ? "Self-join" : "Join", m_1, self_join ? m_1 : m_2, tau, got.size(), ok ? "same as" : "DIFFERENT FROM");
+	}
+
+	// Then the whole sets, the pairs being streamed to the output file if any.
+	for (const bool self_join : {false, true}) {
+		ciede_2000_join_stats stats;
+		const double t = seconds([&] {
+			stats = ciede_2000_join(catalog.begin(), n_1, library.begin(), n_2, tau, self_join, [&](const std::vector<triple> &batch) {
+				if (out)
+					for (const auto &p : batch)
+						std::fprintf(out, "%zu,%zu,%.17g\n", p.i, p.j, p.delta_e);
+			});
+		});
+		const double n_pairs = self_join ? (double) n_1 * (double) (n_1 - 1) * 0.5 : (double) n_1 * (double) n_2;
+		std::printf("%s of %zu x %zu colors : %llu pairs found in %.2f s, %.4f%% of the pairs evaluated.\n", self_join ? "Self-join" : "Join", n_1, self_join ? n_1 : n_2, (unsigned long long) stats.n_found, t, 100.0 * (double) stats.n_evaluated / n_pairs);
+	}
+	if (out)
+		std::fclose(out);
+	if (n_errors)
+		std::printf("  - FAIL : The join missed pairs, or reported extra pairs\n");
+	else
+		std::printf("  - PASS : The join reported the pairs of the brute force\n");
+	return n_errors != 0;
+}
+
+// The compilation is done using GCC or CLang :
+// - g++ -std=c++17 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-join ciede-2000-join.cpp
+// - clang++ -std=c++17 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-join ciede-2000-join.cpp
@@ -0,0 +1,397 @@
+// This function written in C++ is not affiliated with the CIE (International Commission on Illumination),
+// and is released into the public domain. It is provided "as is" without any warranty, express or implied.
+
+// This profiler needs π with the 113 bits of __float128 in the ciede_2000 template below, T(M_PI) remaining the
+// correctly rounded π in float and double, so that their instantiations are unchanged.
+#include <quadmath.h>
+#include <cmath>
+static const __float128 quad_pi = strtoflt128("3.14159265358979323846264338327950288419716939937511", nullptr);
+#undef M_PI
+#define M_PI quad_pi
+
+// The functions of libquadmath, called by the ciede_2000<__float128> instantiation of the template.
+namespace std {
+	inline __float128 sqrt(const __float128 x) { return sqrtq(x); }
+	inline __float128 atan2(const __float128 y, const __float128 x) { return atan2q(y, x); }
+	inline __float128 sin(const __float128 x) { return sinq(x); }
+	inline __float128 exp(const __float128 x) { return expq(x); }
+	inline __float128 fabs(const __float128 x) { return fabsq(x); }
+}
+
+#include <cmath>
+
+// Expressly defining pi ensures that the code works on different platforms.
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327950288419716939937511
+#endif
+
+// The classic CIE ΔE2000 implementation, which operates on two L*a*b* colors, and returns their difference.
+// "l" ranges from 0 to 100, while "a" and "b" are unbounded and commonly clamped to the range of -128 to 127.
+template<typename T>
+static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T a_2, const T b_2) {
+	// Working in C++ with the CIEDE2000 color-difference formula.
+	// k_l, k_c, k_h are parametric factors to be adjusted according to
+	// different viewing parameters such as textures, backgrounds...
+	const T k_l = T(1.0);
+	const T k_c = T(1.0);
+	const T k_h = T(1.0);
+	T n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// A factor involving chroma raised to the power of 7 designed to make
+	// the influence of chroma on the total color difference more accurate.
+	n = T(1.0) + T(0.5) * (T(1.0) - std::sqrt(n / (n + T(6103515625.0))));
+	// Application of the chroma correction factor.
+	const T c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1);
+	const T c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	// atan2 is preferred over atan because it accurately computes the angle of
+	// a point (x, y) in all quadrants, handling the signs of both coordinates.
+	T h_1 = std::atan2(b_1, a_1 * n);
+	T h_2 = std::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
+	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
+	n = std::fabs(h_2 - h_1);
+	// Cross-implementation consistent rounding.
+	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
+		n = T(M_PI);
+	// When the hue angles lie in different quadrants, the straightforward
+	// average can produce a mean that incorrectly suggests a hue angle in
+	// the wrong quadrant, the next lines handle this issue.
+	T h_m = (h_1 + h_2) * T(0.5);
+	T h_d = (h_2 - h_1) * T(0.5);
+	h_d += (T(M_PI) < n) * T(M_PI);
+	// 📜 Sharma’s formulation doesn’t use the next line, but the one after it,
+	// and these two variants differ by ±0.0003 on the final color differences.
+	h_m += (T(M_PI) < n) * T(M_PI);
+	// h_m += (T(M_PI) < n) * ((h_m < T(M_PI)) - (T(M_PI) <= h_m)) * T(M_PI);
+	const T p = T(36.0) * h_m - T(55.0) * T(M_PI);
+	n = (c_1 + c_2) * T(0.5);
+	n = n * n * n * n * n * n * n;
+	// The hue rotation correction term is designed to account for the
+	// non-linear behavior of hue differences in the blue region.
+	const T r_t = T(-2.0) * std::sqrt(n / (n + T(6103515625.0)))
+			* std::sin(T(M_PI) / T(3.0) * std::exp(p * p / (T(-25.0) * T(M_PI) * T(M_PI))));
+	n = (l_1 + l_2) * T(0.5);
+	n = (n - T(50.0)) * (n - T(50.0));
+	// Lightness.
+	const T l = (l_2 - l_1) / (k_l * (T(1.0) + T(3.0) / T(200.0) * n / std::sqrt(T(20.0) + n)));
+	// These coefficients adjust the impact of different harmonic
+	// components on the hue difference calculation.
+	const T t = T(1.0) 	+ T(6.0) / T(25.0) * std::sin(T(2.0) * h_m + T(M_PI) / T(2.0))
+				+ T(8.0) / T(25.0) * std::sin(T(3.0) * h_m + T(8.0) * T(M_PI) / T(15.0))
+				- T(17.0) / T(100.0) * std::sin(h_m + T(M_PI) / T(3.0))
+				- T(1.0) / T(5.0) * std::sin(T(4.0) * h_m + T(3.0) * T(M_PI) / T(20.0));
+	n = c_1 + c_2;
+	// Hue.
+	const T h = T(2.0) * std::sqrt(c_1 * c_2) * std::sin(h_d) / (k_h * (T(1.0) + T(3.0) / T(400.0) * n * t));
+	// Chroma.
+	const T c = (c_2 - c_1) / (k_c * (T(1.0) + T(9.0) / T(400.0) * n));
+	// Returning the square root ensures that dE00 accurately reflects the
+	// geometric distance in color space, which can range from 0 to around 185.
+	return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+// GitHub Project : https://github.com/michel-leonard/ciede2000-color-matching
+//   Online Tests : https://michel-leonard.github.io/ciede2000-color-matching
+
+// L1 = 96.5   a1 = 47.8   b1 = 4.6
+// L2 = 96.8   a2 = 53.2   b2 = -4.1
+// CIE ΔE00 = 4.6680978034 (Bruce Lindbloom, Netflix’s VMAF, ...)
+// CIE ΔE00 = 4.6680847226 (Gaurav Sharma, OpenJDK, ...)
+// Deviation between implementations ≈ 1.3e-5
+
+// See the source code comments for easy switching between these two widely used ΔE*00 implementation variants.
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////     Quad Precision Profiler     ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// The ciede_2000<__float128> instantiation, with 113-bit computations and libquadmath, is the ground truth
+// against which the fast kernels are measured : their absolute errors, and their errors in units in the last
+// place (ULP) of their own precision, on adversarial color pairs evaluated by all the CPU cores. The fastest
+// kernel meeting each accuracy contract is then reported.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+// A table-based kernel, in 64-bit : the hue weighting T and the exponential of the rotation term R_T, which only
+// depend on the mean hue, are interpolated from a table of 4096 intervals covering its range [0, 3π].
+class ciede_2000_table {
+	static constexpr int size = 4096;
+	double t[size + 2], r[size + 2];
+
+public:
+	ciede_2000_table() {
+		const double pi = 3.14159265358979323846;
+		for (int i = 0; i <= size + 1; ++i) {
+			const double h_m = 3.0 * pi * i / size, p = 36.0 * h_m - 55.0 * pi;
+			t[i] = 1.0 + 0.24 * std::sin(2.0 * h_m + pi / 2.0) + 0.32 * std::sin(3.0 * h_m + 8.0 * pi / 15.0)
+				- 0.17 * std::sin(h_m + pi / 3.0) - 0.2 * std::sin(4.0 * h_m + 3.0 * pi / 20.0);
+			r[i] = std::sin(pi / 3.0 * std::exp(p * p / (-25.0 * pi * pi)));
+		}
+	}
+
+	double operator()(const double l_1, const double a_1, const double b_1, const double l_2, const double a_2, const double b_2) const {
+		const double pi = 3.14159265358979323846;
+		double n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * 0.5;
+		n = n * n * n * n * n * n * n;
+		n = 1.0 + 0.5 * (1.0 - std::sqrt(n / (n + 6103515625.0)));
+		const double c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1), c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+		double h_1 = std::atan2(b_1, a_1 * n), h_2 = std::atan2(b_2, a_2 * n);
+		h_1 += (h_1 < 0.0) * 2.0 * pi;
+		h_2 += (h_2 < 0.0) * 2.0 * pi;
+		n = std::fabs(h_2 - h_1);
+		if (pi - 1E-14 < n && n < pi + 1E-14)
+			n = pi;
+		double h_m = (h_1 + h_2) * 0.5, h_d = (h_2 - h_1) * 0.5;
+		h_d += (pi < n) * pi;
+		h_m += (pi < n) * pi;
+		const double x = h_m * (size / (3.0 * pi)), f = x - std::floor(x);
+		const int i = std::min((int) x, size);
+		const double t_m = t[i] + (t[i + 1] - t[i]) * f, r_m = r[i] + (r[i + 1] - r[i]) * f;
+		n = (c_1 + c_2) * 0.5;
+		n = n * n * n * n * n * n * n;
+		const double r_t = -2.0 * std::sqrt(n / (n + 6103515625.0)) * r_m;
+		n = (l_1 + l_2) * 0.5;
+		n = (n - 50.0) * (n - 50.0);
+		const double l = (l_2 - l_1) / (1.0 + 0.015 * n / std::sqrt(20.0 + n));
+		n = c_1 + c_2;
+		const double h = 2.0 * std::sqrt(c_1 * c_2) * std::sin(h_d) / (1.0 + 0.0075 * n * t_m);
+		const double c = (c_2 - c_1) / (1.0 + 0.0225 * n);
+		return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+	}
+};
+
+// An approximate kernel, in 32-bit : polynomial arctangents and sines, with a 2 ULP error in float for the sines
+// and about 1E-5 radian for the arctangents.
+namespace ciede_2000_approximate_detail {
+	inline float atan2(const float y, const float x) {
+		const float pi = 3.14159265f, ax = std::fabs(x), ay = std::fabs(y);
+		const float z = std::min(ax, ay) / std::max(std::max(ax, ay), 1E-30f), z_2 = z * z;
+		float r = z * (0.99997726f + z_2 * (-0.33262347f + z_2 * (0.19354346f + z_2 * (-0.11643287f + z_2 * (0.05265332f - 0.01172120f * z_2)))));
+		r = ay > ax ? pi * 0.5f - r : r;
+		r = x < 0.0f ? pi - r : r;
+		return y < 0.0f ? -r : r;
+	}
+
+	inline float sin(float x) {
+		const float pi = 3.14159265f;
+		x -= 2.0f * pi * std::nearbyint(x * (0.5f / pi));
+		x = x > pi * 0.5f ? pi - x : x < -pi * 0.5f ? -pi - x : x;
+		const float x_2 = x * x;
+		return x * (1.0f + x_2 * (-1.6666667e-1f + x_2 * (8.3333338e-3f + x_2 * (-1.9840874e-4f + x_2 * (2.7525562e-6f - 2.3889859e-8f * x_2)))));
+	}
+}
+
+static float ciede_2000_approximate(const float l_1, const float a_1, const float b_1, const float l_2, const float a_2, const float b_2) {
+	namespace fast = ciede_2000_approximate_detail;
+	const float pi = 3.14159265f;
+	float n = (std::sqrt(a_1 * a_1 + b_1 * b_1) + std::sqrt(a_2 * a_2 + b_2 * b_2)) * 0.5f;
+	n = n * n * n * n * n * n * n;
+	n = 1.0f + 0.5f * (1.0f - std::sqrt(n / (n + 6103515625.0f)));
+	const float c_1 = std::sqrt(a_1 * a_1 * n * n + b_1 * b_1), c_2 = std::sqrt(a_2 * a_2 * n * n + b_2 * b_2);
+	float h_1 = fast::atan2(b_1, a_1 * n), h_2 = fast::atan2(b_2, a_2 * n);
+	h_1 += (h_1 < 0.0f) * 2.0f * pi;
+	h_2 += (h_2 < 0.0f) * 2.0f * pi;
+	n = std::fabs(h_2 - h_1);
+	if (pi - 1E-6f < n && n < pi + 1E-6f)
+		n = pi;
+	float h_m = (h_1 + h_2) * 0.5f, h_d = (h_2 - h_1) * 0.5f;
+	h_d += (pi < n) * pi;
+	h_m += (pi < n) * pi;
+	const float p = 36.0f * h_m - 55.0f * pi;
+	n = (c_1 + c_2) * 0.5f;
+	n = n * n * n * n * n * n * n;
+	const float r_t = -2.0f * std::sqrt(n / (n + 6103515625.0f)) * fast::sin(pi / 3.0f * std::exp(p * p / (-25.0f * pi * pi)));
+	n = (l_1 + l_2) * 0.5f;
+	n = (n - 50.0f) * (n - 50.0f);
+	const float l = (l_2 - l_1) / (1.0f + 0.015f * n / std::sqrt(20.0f + n));
+	const float t = 1.0f + 0.24f * fast::sin(2.0f * h_m + pi / 2.0f) + 0.32f * fast::sin(3.0f * h_m + 8.0f * pi / 15.0f)
+			- 0.17f * fast::sin(h_m + pi / 3.0f) - 0.2f * fast::sin(4.0f * h_m + 3.0f * pi / 20.0f);
+	n = c_1 + c_2;
+	const float h = 2.0f * std::sqrt(c_1 * c_2) * fast::sin(h_d) / (1.0f + 0.0075f * n * t);
+	const float c = (c_2 - c_1) / (1.0f + 0.0225f * n);
+	return std::sqrt(l * l + h * h + c * c + c * h * r_t);
+}
+
+static inline uint64_t splitmix(uint64_t x) {
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+	return x ^ (x >> 31);
+}
+
+// The i-th color pair of a run depends only on the seed and on i, not on the number of threads.
+static void color_pair(const uint64_t seed, const uint64_t i, double c[6]) {
+	uint64_t s = splitmix(seed ^ splitmix(i));
+	const auto uniform = [&](const double min, const double max) {
+		s = splitmix(s + 0x9e3779b97f4a7c15);
+		return min + (max - min) * (double) (s >> 11) * (1.0 / 9007199254740992.0);
+	};
+	c[0] = uniform(0.0, 100.0), c[1] = uniform(-128.0, 128.0), c[2] = uniform(-128.0, 128.0);
+	switch (i & 3) {
+	case 0 : // Random colors.
+		c[3] = uniform(0.0, 100.0), c[4] = uniform(-128.0, 128.0), c[5] = uniform(-128.0, 128.0);
+		break;
+	case 1 : // Close colors, where the relative errors are the largest.
+		c[3] = c[0] + uniform(-0.5, 0.5), c[4] = c[1] + uniform(-0.5, 0.5), c[5] = c[2] + uniform(-0.5, 0.5);
+		break;
+	case 2 : // Hues about π apart, where the mean hue jumps.
+		c[3] = uniform(0.0, 100.0), c[4] = -c[1] * uniform(0.1, 2.0) + uniform(-1E-3, 1E-3), c[5] = -c[2] * uniform(0.1, 2.0);
+		break;
+	default : // Nearly achromatic colors, rounded to 0.1 like the measurements.
+		for (int k = 0; k < 6; ++k)
+			c[k] = std::round((k % 3 ? uniform(-2.0, 2.0) : uniform(0.0, 100.0)) * 10.0) / 10.0;
+	}
+}
+
+struct kernel {
+	const char *name;
+	double (*delta_e)(const double *c);
+	double ulp_scale; // The ULP of 1.0 in the precision of the kernel.
+	double band; // How close to π the hue difference must be for the kernel to take either side of the jump.
+};
+
+static const ciede_2000_table table;
+
+static const kernel kernels[] = {
+	{"64-bit", [](const double *c) { return ciede_2000<double>(c[0], c[1], c[2], c[3], c[4], c[5]); }, std::numeric_limits<double>::epsilon(), 1E-12},
+	{"32-bit", [](const double *c) { return (double) ciede_2000<float>((float) c[0], (float) c[1], (float) c[2], (float) c[3], (float) c[4], (float) c[5]); }, std::numeric_limits<float>::epsilon(), 1E-4},
+	{"80-bit", [](const double *c) { return (double) ciede_2000<long double>(c[0], c[1], c[2], c[3], c[4], c[5]); }, std::numeric_limits<double>::epsilon(), 1E-12},
+	{"Table", [](const double *c) { return table(c[0], c[1], c[2], c[3], c[4], c[5]); }, std::numeric_limits<double>::epsilon(), 1E-12},
+	{"Approximate", [](const double *c) { return (double) ciede_2000_approximate((float) c[0], (float) c[1], (float) c[2], (float) c[3], (float) c[4], (float) c[5]); }, std::numeric_limits<float>::epsilon(), 1E-4},
+};
+
+static constexpr int n_kernels = sizeof(kernels) / sizeof(*kernels);
+
+// The distance between π and the hue difference of the pair, in 113-bit : near 0, the mean hue jumps by π, and
+// the ΔE2000 of a pair is discontinuous, so that the rounding of the inputs or of the atan2 can pick either side.
+static double hue_jump(const double *c) {
+	__float128 n = (sqrtq((__float128) c[1] * c[1] + (__float128) c[2] * c[2]) + sqrtq((__float128) c[4] * c[4] + (__float128) c[5] * c[5])) / 2;
+	n = n * n * n * n * n * n * n;
+	n = 1 + (1 - sqrtq(n / (n + 6103515625))) / 2;
+	__float128 h_1 = atan2q(c[2], c[1] * n), h_2 = atan2q(c[5], c[4] * n);
+	h_1 += (h_1 < 0) * 2 * quad_pi;
+	h_2 += (h_2 < 0) * 2 * quad_pi;
+	return (double) fabsq(fabsq(h_2 - h_1) - quad_pi);
+}
+
+static double ulp(const double x, const double scale) {
+	// The spacing of the floating-point numbers around x, in the precision of the kernel (the 80-bit kernel
+	// being rounded to 64-bit, its ULP is that of the double).
+	int e;
+	std::frexp(x, &e);
+	return x == 0.0 ? std::numeric_limits<double>::denorm_min() : std::ldexp(scale, e - 1);
+}
+
+static double quantile(std::vector<double> &v, const double q) {
+	const size_t k = std::min(v.size() - 1, (size_t) (q * (double) v.size()));
+	std::nth_element(v.begin(), v.begin() + (long) k, v.end());
+	return v[k];
+}
+
+template<typename F>
+static double seconds(const F &f) {
+	const auto t_1 = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t_1).count();
+}
+
+int main(int argc, char *argv[]) {
+	// Usage : ./ciede-2000-quad [number of pairs] [seed]
+	const long parsed_n = 1 < argc ? std::strtol(argv[1], nullptr, 10) : 0;
+	const size_t n = parsed_n < 1 ? 1000000 : (size_t) parsed_n;
+	const uint64_t parsed_seed = std::strtoull(2 < argc ? argv[2] : "0", nullptr, 10);
+	const uint64_t seed = parsed_seed ? parsed_seed : (uint64_t) std::chrono::system_clock::now().time_since_epoch().count();
+	const unsigned n_threads = std::max(1U, std::thread::hardware_concurrency());
+
+	// The errors of each kernel on each pair, computed by all the threads.
+	// The pairs close to a jump of the mean hue are counted apart, their errors being up to the size of the jump.
+	std::vector<double> absolute[n_kernels], ulps[n_kernels];
+	std::atomic<uint64_t> n_jumps[n_kernels];
+	for (int k = 0; k < n_kernels; ++k)
+		absolute[k].resize(n), ulps[k].resize(n), n_jumps[k] = 0;
+	std::atomic<size_t> next(0);
+	const double t_reference = seconds([&] {
+		const auto work = [&] {
+			double c[6];
+			for (size_t begin; (begin = next.fetch_add(4096)) < n;)
+				for (size_t i = begin; i < std::min(n, begin + 4096); ++i) {
+					color_pair(seed, i, c);
+					const __float128 expected = ciede_2000<__float128>(c[0], c[1], c[2], c[3], c[4], c[5]);
+					const double jump = hue_jump(c);
+					for (int k = 0; k < n_kernels; ++k) {
+						double error = (double) fabsq((__float128) kernels[k].delta_e(c) - expected);
+						if (jump < kernels[k].band)
+							error = 0.0, ++n_jumps[k];
+						absolute[k][i] = error;
+						ulps[k][i] = error / ulp((double) expected, kernels[k].ulp_scale);
+					}
+				}
+		};
+		std::vector<std::thread> threads;
+		for (unsigned i = 1; i < n_threads; ++i)
+			threads.emplace_back(work);
+		work();
+		for (auto &t : threads)
+			t.join();
+	});
+	std::printf("Profiled %zu color pairs (seed %llu) against the 113-bit reference on %u threads in %.2f s.\n\n", n, (unsigned long long) seed, n_threads, t_reference);
+
+	// The throughput of each kernel, on a single thread.
+	std::vector<double> pairs(6 * std::min<size_t>(n, 1 << 18));
+	for (size_t i = 0; i < pairs.size() / 6; ++i)
+		color_pair(seed, i, &pairs[6 * i]);
+	double speed[n_kernels], max_error[n_kernels];
+	volatile double sink = 0.0;
+	std::printf("%-12s %12s | %9s %9s %9s %9s | %9s %9s %9s %9s | %s\n", "Kernel", "Pairs/s", "p50 abs", "p99 abs", "p99.9 abs", "Max abs", "p50 ULP", "p99 ULP", "p99.9 ULP", "Max ULP", "Jumps");
+	for (int k = 0; k < n_kernels; ++k) {
+		double sum = 0.0;
+		const double t = seconds([&] {
+			for (size_t i = 0; i < pairs.size(); i += 6)
+				sum += kernels[k].delta_e(&pairs[i]);
+		});
+		sink = sink + sum;
+		speed[k] = (double) (pairs.size() / 6) / t;
+		max_error[k] = *std::max_element(absolute[k].begin(), absolute[k].end());
+		std::printf("%-12s %12.4g | %9.2e %9.2e %9.2e %9.2e | %9.3g %9.3g %9.3g %9.3g | %llu\n", kernels[k].name, speed[k],
+			quantile(absolute[k], 0.5), quantile(absolute[k], 0.99), quantile(absolute[k], 0.999), max_error[k],
+			quantile(ulps[k], 0.5), quantile(ulps[k], 0.99), quantile(ulps[k], 0.999), *std::max_element(ulps[k].begin(), ulps[k].end()),
+			(unsigned long long) n_jumps[k].load());
+	}
+
+	// An accuracy contract is a maximum absolute error, met by the fastest kernel below it.
+	std::printf("\n");
+	for (const double contract : {1E-12, 1E-10, 1E-6, 1E-4, 1E-3, 1E-2}) {
+		int best = -1;
+		for (int k = 0; k < n_kernels; ++k)
+			if (max_error[k] <= contract && (best < 0 || speed[best] < speed[k]))
+				best = k;
+		if (best < 0)
+			std::printf("Contract %.0e : no kernel\n", contract);
+		else
+			std::printf("Contract %.0e : %s (%.3g pairs per second)\n", contract, kernels[best].name, speed[best]);
+	}
+
+	// The tolerances documented in ciede-2000-constexpr.cpp, measured against the 113-bit reference (the 32-bit
+	// errors, which include the rounding of the inputs to float, reach 0.000166 on millions of pairs).
+	const bool ok = max_error[0] <= 3.4E-13 && max_error[1] <= 2E-4;
+	if (ok)
+		std::printf("\n  - PASS : The 64-bit and 32-bit errors are within 3.4e-13 and 0.0002\n");
+	else
+		std::printf("\n  - FAIL : The 64-bit error (%.2e) or the 32-bit error (%.2e) exceeds 3.4e-13 or 0.0002\n", max_error[0], max_error[1]);
+	return !ok;
+}
+
+// The compilation is done using GCC (libquadmath ships with it on x86 and other targets) :
+// - g++ -std=c++17 -Wall -Wextra -pedantic -O3 -pthread -o ciede-2000-quad ciede-2000-quad.cpp -lquadmath
@@ -33,9 +33,8 @@ static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T
 	h_1 += (h_1 < T(0.0)) * T(2.0) * T(M_PI);
 	h_2 += (h_2 < T(0.0)) * T(2.0) * T(M_PI);
 	n = std::fabs(h_2 - h_1);
-	// Cross-implementation consistent rounding.
-	if (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14))
-		n = T(M_PI);
+	// Cross-implementation consistent rounding, without a branch so that T can be a vector type.
+	n += (T(M_PI) - T(1E-14) < n && n < T(M_PI) + T(1E-14)) * (T(M_PI) - n);
 	// When the hue angles lie in different quadrants, the straightforward
 	// average can produce a mean that incorrectly suggests a hue angle in
 	// the wrong quadrant, the next lines handle this issue.
@@ -102,47 +101,206 @@ static T ciede_2000(const T l_1, const T a_1, const T b_1, const T l_2, const T
 // - With the C driver, which provides a dedicated verification feature
 // - By using the JavaScript validator at https://michel-leonard.github.io/ciede2000-color-matching
 
-#include <iostream>
+// The pairs are made by blocks : a block is drawn by 16 interleaved xoshiro256++ streams into one array per
+// component, its ΔE2000 are computed over these arrays, then its lines are formatted into a buffer, and the
+// buffers are written in the order of the blocks. The streams of a block only depend on the seed and on the
+// index of the block, so that the threads can share the blocks while the output only depends on the --seed.
+// Usage : ./ciede-2000-random [count] [--32-bit] [--seed <n>] [--threads <n>] [--benchmark]
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <random>
-#include <string>
+#include <thread>
+#include <vector>
 
-template<typename T>
-T round_to_n_decimals(T value, int n) {
-	const T factor = T(n ? n == 1 ? 10.0 : 100.0 : 1.0);
-	return std::round(value * factor) / factor;
+namespace ciede_2000_random {
+	constexpr int LANES = 16;
+	constexpr size_t BLOCK = 8192;
+
+	static inline uint64_t splitmix64(uint64_t &x) {
+		uint64_t z = (x += 0x9e3779b97f4a7c15);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		return z ^ (z >> 31);
+	}
+
+	// The xoshiro256++ generator of David Blackman and Sebastiano Vigna, in LANES independent streams whose
+	// states are stored by word, so that one step of all the streams compiles to a few vector instructions.
+	struct xoshiro {
+		uint64_t s[4][LANES];
+
+		xoshiro(const uint64_t seed, const uint64_t block) {
+			uint64_t x = seed ^ block * 0xd1342543de82ef95;
+			for (int k = 0; k < LANES; ++k)
+				for (int j = 0; j < 4; ++j)
+					s[j][k] = splitmix64(x);
+		}
+
+		inline void next(uint64_t (&r)[LANES]) {
+			for (int k = 0; k < LANES; ++k) {
+				const uint64_t x = s[0][k] + s[3][k], t = s[1][k] << 17;
+				r[k] = ((x << 23) | (x >> 41)) + s[0][k];
+				s[2][k] ^= s[0][k];
+				s[3][k] ^= s[1][k];
+				s[1][k] ^= s[2][k];
+				s[0][k] ^= s[3][k];
+				s[2][k] ^= t;
+				s[3][k] = (s[3][k] << 45) | (s[3][k] >> 19);
+			}
+		}
+	};
+
+	// Rounds half away from zero as std::round does, in a form that the compiler vectorizes.
+	template<typename T>
+	static inline T round(const T x) {
+		return std::trunc(x + std::copysign(T(0.5) - std::numeric_limits<T>::epsilon() / T(4.0), x));
+	}
+
+	// Fills n values (a multiple of LANES) uniformly drawn in [min, max), each rounded to 0, 1 or 2 decimals with
+	// the same probability. The high half of a draw gives the value, and its low half gives the decimals.
+	template<typename T>
+	static void fill(xoshiro &g, uint64_t *r, T *x, const size_t n, const T min, const T max) {
+		// The streams are copied to a local, which the compiler can keep in registers as r can't alias it.
+		xoshiro local = g;
+		for (size_t i = 0; i < n; i += LANES)
+			local.next(*reinterpret_cast<uint64_t (*)[LANES]>(r + i));
+		g = local;
+		for (size_t i = 0; i < n; ++i) {
+			const T value = min + (max - min) * T(int32_t(r[i] >> 33)) * T(1.0 / 2147483648.0);
+			const int32_t decimals = int32_t(uint32_t(r[i]) >> 1);
+			const T factor = T(decimals < 715827883 ? 1.0 : decimals < 1431655765 ? 10.0 : 100.0);
+			x[i] = round(value * factor) / factor;
+		}
+	}
+
+	// The pairs of a block, by component, with their ΔE2000 and their lines of text.
+	template<typename T>
+	struct block {
+		std::vector<T> l_1, a_1, b_1, l_2, a_2, b_2, delta_e;
+		std::vector<uint64_t> draws;
+		std::vector<char> text;
+		size_t n_text = 0;
+
+		block() : l_1(BLOCK), a_1(BLOCK), b_1(BLOCK), l_2(BLOCK), a_2(BLOCK), b_2(BLOCK), delta_e(BLOCK), draws(BLOCK), text(BLOCK * 160) {}
+
+		void generate(const uint64_t seed, const uint64_t index) {
+			xoshiro g(seed, index);
+			fill(g, draws.data(), l_1.data(), BLOCK, T(0.0), T(100.0));
+			fill(g, draws.data(), a_1.data(), BLOCK, T(-128.0), T(127.0));
+			fill(g, draws.data(), b_1.data(), BLOCK, T(-128.0), T(127.0));
+			fill(g, draws.data(), l_2.data(), BLOCK, T(0.0), T(100.0));
+			fill(g, draws.data(), a_2.data(), BLOCK, T(-128.0), T(127.0));
+			fill(g, draws.data(), b_2.data(), BLOCK, T(-128.0), T(127.0));
+		}
+
+		void solve(const size_t n) {
+			for (size_t i = 0; i < n; ++i)
+				delta_e[i] = ciede_2000(l_1[i], a_1[i], b_1[i], l_2[i], a_2[i], b_2[i]);
+		}
+
+		// The same text as printf with "%g,%g,%g,%g,%g,%g,%.17g\n" (or "%.10g" for the ΔE2000 in 32-bit).
+		void format(const size_t n) {
+			const int digits = sizeof(T) == sizeof(float) ? 10 : 17;
+			char *p = text.data(), *end = p + text.size();
+			for (size_t i = 0; i < n; ++i) {
+				const T x[6] = {l_1[i], a_1[i], b_1[i], l_2[i], a_2[i], b_2[i]};
+				for (const T v : x) {
+					p = std::to_chars(p, end, v, std::chars_format::general, 6).ptr;
+					*p++ = ',';
+				}
+				p = std::to_chars(p, end, delta_e[i], std::chars_format::general, digits).ptr;
+				*p++ = '\n';
+			}
+			n_text = (size_t) (p - text.data());
+		}
+	};
+
+	// What a run does with the blocks, the benchmark stopping after each of the 3 stages.
+	enum stage { GENERATE, SOLVE, FORMAT, WRITE };
+
+	// Makes n pairs with n_threads threads, each one taking the next block, and returns a checksum of the ΔE2000.
+	template<typename T>
+	static double run(const uint64_t n, const uint64_t seed, const int n_threads, const stage last, FILE *out) {
+		const uint64_t n_blocks = (n + BLOCK - 1) / BLOCK;
+		// A round gives a few blocks to each thread, then writes them in order.
+		const uint64_t per_round = (uint64_t) n_threads * 4;
+		std::vector<block<T>> blocks(std::min(per_round, n_blocks));
+		double checksum = 0.0;
+		for (uint64_t first = 0; first < n_blocks; first += per_round) {
+			const uint64_t n_round = std::min(per_round, n_blocks - first);
+			std::atomic<uint64_t> next(0);
+			const auto work = [&] {
+				for (uint64_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n_round;) {
+					block<T> &b = blocks[i];
+					const size_t size = (size_t) std::min<uint64_t>(BLOCK, n - (first + i) * BLOCK);
+					b.generate(seed, first + i);
+					if (SOLVE <= last)
+						b.solve(size);
+					if (FORMAT <= last)
+						b.format(size);
+				}
+			};
+			std::vector<std::thread> threads;
+			for (int i = 1; i < n_threads && (uint64_t) i < n_round; ++i)
+				threads.emplace_back(work);
+			work();
+			for (auto &t : threads)
+				t.join();
+			for (uint64_t i = 0; i < n_round; ++i) {
+				checksum += double(last == GENERATE ? blocks[i].l_1[0] + blocks[i].b_2[BLOCK - 1] : blocks[i].delta_e[0]);
+				if (last == WRITE)
+					std::fwrite(blocks[i].text.data(), 1, blocks[i].n_text, out);
+			}
+		}
+		return checksum;
+	}
 }
 
 template<typename T>
-void run_iterations(int n_iterations, const char *fmt) {
-	std::random_device rd;
-	std::mt19937 gen(rd());
-
-	std::uniform_real_distribution<T> dist_l(0.0, 100.0);
-	std::uniform_real_distribution<T> dist_ab(-128.0, 127.0);
-	std::uniform_int_distribution<int> decimals(0, 2);
-
-	for (int i = 0; i < n_iterations; ++i) {
-		T l1 = round_to_n_decimals(dist_l(gen), decimals(gen));
-		T a1 = round_to_n_decimals(dist_ab(gen), decimals(gen));
-		T b1 = round_to_n_decimals(dist_ab(gen), decimals(gen));
-		T l2 = round_to_n_decimals(dist_l(gen), decimals(gen));
-		T a2 = round_to_n_decimals(dist_ab(gen), decimals(gen));
-		T b2 = round_to_n_decimals(dist_ab(gen), decimals(gen));
-		T delta_e = ciede_2000(l1, a1, b1, l2, a2, b2);
-		std::printf(fmt, l1, a1, b1, l2, a2, b2, delta_e);
+static void benchmark(const uint64_t n, const uint64_t seed, const int n_threads) {
+	using namespace ciede_2000_random;
+	const char *names[] = {"Random L*a*b* pairs", "With their ΔE2000", "With their CSV lines"};
+	std::printf("Pairs per second, %s, with %d thread%s :\n", sizeof(T) == sizeof(float) ? "32-bit" : "64-bit", n_threads, n_threads == 1 ? "" : "s");
+	for (const stage s : {GENERATE, SOLVE, FORMAT}) {
+		const auto t_1 = std::chrono::steady_clock::now();
+		const double checksum = run<T>(n, seed, n_threads, s, nullptr);
+		const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_1).count();
+		std::printf("  - %10.3e : %s (checksum %g)\n", (double) n / t, names[s], checksum);
 	}
 }
 
 int main(int argc, char *argv[]) {
-	int n_iterations = 10000;
-	if (1 < argc)
-		try {
-			int val = std::stoi(argv[1]);
-			if (0 < val)
-				n_iterations = val;
-		} catch (...) {}
-	bool use_float = (2 < argc) && std::string(argv[2]) == "--32-bit";
-	if (use_float) run_iterations<float>(n_iterations, "%g,%g,%g,%g,%g,%g,%.10g\n");
-	else run_iterations<double>(n_iterations, "%g,%g,%g,%g,%g,%g,%.17g\n");
+	uint64_t n_iterations = 10000, seed = std::random_device()() * 0x100000001ULL ^ (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+	int n_threads = (int) std::max(1U, std::thread::hardware_concurrency());
+	bool use_float = false, use_benchmark = false;
+	for (int i = 1; i < argc; ++i)
+		if (!std::strcmp(argv[i], "--32-bit"))
+			use_float = true;
+		else if (!std::strcmp(argv[i], "--benchmark"))
+			use_benchmark = true;
+		else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+			n_threads = std::max(1, (int) std::strtol(argv[++i], nullptr, 10));
+		else if (0 < std::strtoll(argv[i], nullptr, 10))
+			n_iterations = std::strtoull(argv[i], nullptr, 10);
+	if (use_benchmark)
+		use_float ? benchmark<float>(n_iterations, seed, n_threads) : benchmark<double>(n_iterations, seed, n_threads);
+	else if (use_float)
+		ciede_2000_random::run<float>(n_iterations, seed, n_threads, ciede_2000_random::WRITE, stdout);
+	else
+		ciede_2000_random::run<double>(n_iterations, seed, n_threads, ciede_2000_random::WRITE, stdout);
 	return 0;
 }
+
+// The compilation is done using GCC or CLang, -fno-math-errno and -fno-trapping-math letting the drawing and the
+// rounding of the components be vectorized, while -ffp-contract=off keeps the ΔE2000 free of fused multiply-adds :
+// - g++ -std=c++17 -Wall -Wextra -pedantic -O3 -march=native -fno-math-errno -fno-trapping-math -ffp-contract=off -pthread -o ciede-2000-random ciede-2000-random.cpp
+// - clang++ -std=c++17 -Wall -Wextra -pedantic -O3 -march=native -fno-math-errno -fno-trapping-math -ffp-contract=off -pthread -o ciede-2000-random ciede-2000-random.cpp
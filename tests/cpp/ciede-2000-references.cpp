@@ -0,0 +1,71 @@
+// This C++ program is released into the public domain.
+// Provided "as is", without any warranty, express or implied.
+
+// The constexpr ciede_2000 of ciede-2000-constexpr.cpp, extracted up to its main function (see the compile
+// lines at the end), so that the references are evaluated by the implementation of the repository itself.
+#include "ciede-2000-constexpr.inc"
+
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+///////                                 ///////
+///////           CIEDE 2000            ///////
+///////     Compile-Time References     ///////
+///////                                 ///////
+///////////////////////////////////////////////
+///////////////////////////////////////////////
+
+// The C driver checks its references (the Basic pairs, Fogra, X-Rite...) at run time, before each job. This
+// program repeats these checks at compile time : the references are extracted from the driver into
+// ciede-2000-references.inc, and each one, in both orders, is evaluated by the constexpr ciede_2000 above.
+// The build fails if one of them drifts, so the program has nothing left to do.
+
+#include <cstdio>
+
+struct reference {
+	double l1;
+	double a1;
+	double b1;
+	double l2;
+	double a2;
+	double b2;
+	double delta_e;
+	double tolerance;
+	enum { SIMPLE, CANONICAL } compliance;
+	const char *name;
+};
+
+constexpr auto SIMPLE = reference::SIMPLE;
+constexpr auto CANONICAL = reference::CANONICAL;
+
+constexpr reference references[] = {
+#include "ciede-2000-references.inc"
+};
+
+// The index of the first reference that fails, in either order, or the number of references when all pass.
+constexpr size_t first_failure() {
+	size_t i = 0;
+	for (const reference &r : references) {
+		const bool canonical = r.compliance == CANONICAL;
+		const double delta_e_1 = ciede_2000(r.l1, r.a1, r.b1, r.l2, r.a2, r.b2, 1.0, 1.0, 1.0, canonical);
+		const double delta_e_2 = ciede_2000(r.l2, r.a2, r.b2, r.l1, r.a1, r.b1, 1.0, 1.0, 1.0, canonical);
+		if (r.tolerance < std::fabs(delta_e_1 - r.delta_e) || r.tolerance < std::fabs(delta_e_2 - r.delta_e))
+			break;
+		++i;
+	}
+	return i;
+}
+
+constexpr size_t n_references = sizeof(references) / sizeof(*references);
+
+static_assert(first_failure() == n_references, "A reference of the driver is not met by the constexpr ciede_2000");
+
+int main() {
+	std::printf("  - PASS : The %zu references of the driver hold in both orders, checked at compile time\n", n_references);
+	return 0;
+}
+
+// The kernel and the references are extracted, then the compilation is done using GCC, which evaluates
+// std::sqrt, std::atan2, std::sin and std::exp as constants (the standard requires it from C++26 on) :
+// - sed '/^int main/,$d' ciede-2000-constexpr.cpp > ciede-2000-constexpr.inc
+// - sed -n '/^static const reference references/,/^};/p' ../c/ciede-2000-driver.c | sed '1d;$d' > ciede-2000-references.inc
+// - g++ -std=c++2b -Wall -Wextra -pedantic -o ciede-2000-references ciede-2000-references.cpp